@@ -76,52 +76,31 @@ public:
 class FocusedFXParam : public FXAction
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 {
-private:
-    int trackNum_ = 0;
-    int fxSlotNum_ = 0;
-    int fxParamNum_ = 0;
-    
 public:
     virtual string GetName() override { return "FocusedFXParam"; }
    
     virtual double GetCurrentNormalizedValue(ActionContext* context) override
     {
-        if(MediaTrack* track = DAW::GetTrack(trackNum_))
-        {
-            double min = 0.0;
-            double max = 0.0;
-            return DAW::TrackFX_GetParam(track, fxSlotNum_, fxParamNum_, &min, &max);
-        }
-        
-        return 0.0;
+        return context->GetPage()->GetLastTouchedFXNormalizedValue();
     }
 
     virtual void RequestUpdate(ActionContext* context) override
     {
-        if(DAW::GetLastTouchedFX(&trackNum_, &fxSlotNum_, &fxParamNum_))
-            if(DAW::GetTrack(trackNum_))
-                context->UpdateWidgetValue(GetCurrentNormalizedValue(context));
+        if(context->GetPage()->GetLastTouchedFX().track)
+            context->UpdateWidgetValue(GetCurrentNormalizedValue(context));
     }
     
     virtual void Do(ActionContext* context, double value) override
     {
-        if(DAW::GetLastTouchedFX(&trackNum_, &fxSlotNum_, &fxParamNum_))
-            if(MediaTrack* track = DAW::GetTrack(trackNum_))
-                DAW::TrackFX_SetParam(track, fxSlotNum_, fxParamNum_, value);
+        context->GetPage()->SetLastTouchedFXParam(value);
     }
     
     virtual void Touch(ActionContext* context, double value) override
     {
-        if(DAW::GetLastTouchedFX(&trackNum_, &fxSlotNum_, &fxParamNum_))
-        {
-            if(MediaTrack* track =  DAW::GetTrack(trackNum_))
-            {
-                if(value == 0)
-                    DAW::TrackFX_EndParamEdit(track, fxSlotNum_, fxParamNum_);
-                else
-                    DAW::TrackFX_SetParam(track, fxSlotNum_, fxParamNum_, GetCurrentNormalizedValue(context));
-            }
-        }
+        if(value == 0)
+            context->GetPage()->EndLastTouchedFXParamEdit();
+        else
+            context->GetPage()->SetLastTouchedFXParam(GetCurrentNormalizedValue(context));
     }
 };
 
@@ -173,17 +152,25 @@ class SoftTakeover7BitTrackVolume : public Action
 public:
     virtual string GetName() override { return "SoftTakeover7BitTrackVolume"; }
     
-    virtual void Do(ActionContext* context, double value) override
+    virtual double GetCurrentNormalizedValue(ActionContext* context) override
     {
         if(MediaTrack* track = context->GetTrack())
         {
             double trackVolume, trackPan = 0.0;
             DAW::GetTrackUIVolPan(track, &trackVolume, &trackPan);
-            trackVolume = volToNormalized(trackVolume);
-            
-            if( fabs(value - trackVolume) < 0.025) // GAW -- Magic number -- ne touche pas
-                DAW::CSurf_SetSurfaceVolume(track, DAW::CSurf_OnVolumeChange(track, normalizedToVol(value), false), NULL);
+            return volToNormalized(trackVolume);
         }
+        else
+            return 0.0;
+    }
+    
+    // The ActionContext only lets the value through once it has caught the track volume, see ActionContextValues::Build for the window.
+    // Once caught it follows the fader, even outside the window, until something else moves the volume -- the old check
+    // dropped every message outside the window, so a quick move could leave the fader stranded
+    virtual void Do(ActionContext* context, double value) override
+    {
+        if(MediaTrack* track = context->GetTrack())
+            DAW::CSurf_SetSurfaceVolume(track, DAW::CSurf_OnVolumeChange(track, normalizedToVol(value), false), NULL);
     }
     
     virtual void Touch(ActionContext* context, double value) override
@@ -199,17 +186,25 @@ class SoftTakeover14BitTrackVolume : public Action
 public:
     virtual string GetName() override { return "SoftTakeover14BitTrackVolume"; }
     
-    virtual void Do(ActionContext* context, double value) override
+    virtual double GetCurrentNormalizedValue(ActionContext* context) override
     {
         if(MediaTrack* track = context->GetTrack())
         {
             double trackVolume, trackPan = 0.0;
             DAW::GetTrackUIVolPan(track, &trackVolume, &trackPan);
-            trackVolume = volToNormalized(trackVolume);
-            
-            if( fabs(value - trackVolume) < 0.0025) // GAW -- Magic number -- ne touche pas
-                DAW::CSurf_SetSurfaceVolume(track, DAW::CSurf_OnVolumeChange(track, normalizedToVol(value), false), NULL);
+            return volToNormalized(trackVolume);
         }
+        else
+            return 0.0;
+    }
+    
+    // The ActionContext only lets the value through once it has caught the track volume, see ActionContextValues::Build for the window.
+    // Once caught it follows the fader, even outside the window, until something else moves the volume -- the old check
+    // dropped every message outside the window, so a quick move could leave the fader stranded
+    virtual void Do(ActionContext* context, double value) override
+    {
+        if(MediaTrack* track = context->GetTrack())
+            DAW::CSurf_SetSurfaceVolume(track, DAW::CSurf_OnVolumeChange(track, normalizedToVol(value), false), NULL);
     }
     
     virtual void Touch(ActionContext* context, double value) override
@@ -696,7 +691,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetSlotIndex() + numHardwareSends, &vol, &pan);
             return volToNormalized(vol);
@@ -717,7 +712,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             DAW::SetTrackSendUIVol(track, context->GetSlotIndex() + numHardwareSends, normalizedToVol(value), 0);
         }
     }
@@ -726,7 +721,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetSlotIndex() + numHardwareSends, &vol, &pan);
             
@@ -749,7 +744,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetParamIndex() + numHardwareSends, &vol, &pan);
             context->UpdateWidgetValue(VAL2DB(vol));
@@ -763,7 +758,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             DAW::SetTrackSendUIVol(track, context->GetParamIndex() + numHardwareSends, DB2VAL(value), 0);
         }
     }
@@ -772,7 +767,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetParamIndex() + numHardwareSends, &vol, &pan);
             
@@ -795,7 +790,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetSlotIndex() + numHardwareSends, &vol, &pan);
             return panToNormalized(pan);
@@ -816,7 +811,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             DAW::SetTrackSendUIPan(track, context->GetSlotIndex() + numHardwareSends, normalizedToPan(value), 0);
         }
     }
@@ -825,7 +820,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetSlotIndex() + numHardwareSends, &vol, &pan);
             
@@ -848,7 +843,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetParamIndex() + numHardwareSends, &vol, &pan);
             context->UpdateWidgetValue(pan * 100.0);
@@ -861,7 +856,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             DAW::SetTrackSendUIPan(track, context->GetParamIndex() + numHardwareSends, value / 100.0, 0);
         }
     }
@@ -870,7 +865,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             double vol, pan = 0.0;
             DAW::GetTrackSendUIVolPan(track, context->GetParamIndex() + numHardwareSends, &vol, &pan);
             
@@ -893,7 +888,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+            int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
             bool mute = false;
             DAW::GetTrackSendUIMute(track, context->GetSlotIndex() + numHardwareSends, &mute);
             return mute;
@@ -1380,11 +1375,7 @@ public:
     virtual void RequestUpdate(ActionContext* context) override
     {
         if(MediaTrack* track = context->GetTrack())
-        {
-            char fxParamValue[128];
-            DAW::TrackFX_GetFormattedParamValue(track, context->GetSlotIndex(), context->GetParamIndex(), fxParamValue, sizeof(fxParamValue));
-            context->UpdateWidgetValue(string(fxParamValue));
-        }
+            context->UpdateWidgetValue(context->GetTrackNavigationManager()->GetFormattedFXParamValue(track, context->GetSlotIndex(), context->GetParamIndex()));
         else
             context->ClearWidget();
     }
@@ -1399,18 +1390,12 @@ public:
     
     virtual void RequestUpdate(ActionContext* context) override
     {
-        int trackNum = 0;
-        int fxSlotNum = 0;
-        int fxParamNum = 0;
+        const LastTouchedFX &lastTouchedFX = context->GetPage()->GetLastTouchedFX();
         
-        if(DAW::GetLastTouchedFX(&trackNum, &fxSlotNum, &fxParamNum))
+        if(lastTouchedFX.isValid)
         {
-            if(MediaTrack* track = DAW::GetTrack(trackNum))
-            {
-                char fxParamName[128];
-                DAW::TrackFX_GetParamName(track, fxSlotNum, fxParamNum, fxParamName, sizeof(fxParamName));
-                context->UpdateWidgetValue(string(fxParamName));
-            }
+            if(lastTouchedFX.track)
+                context->UpdateWidgetValue(lastTouchedFX.paramName);
         }
         else
             context->ClearWidget();
@@ -1426,18 +1411,12 @@ public:
     
     virtual void RequestUpdate(ActionContext* context) override
     {
-        int trackNum = 0;
-        int fxSlotNum = 0;
-        int fxParamNum = 0;
+        const LastTouchedFX &lastTouchedFX = context->GetPage()->GetLastTouchedFX();
         
-        if(DAW::GetLastTouchedFX(&trackNum, &fxSlotNum, &fxParamNum))
+        if(lastTouchedFX.isValid)
         {
-            if(MediaTrack* track = DAW::GetTrack(trackNum))
-            {
-                char fxParamValue[128];
-                DAW::TrackFX_GetFormattedParamValue(track, fxSlotNum, fxParamNum, fxParamValue, sizeof(fxParamValue));
-                context->UpdateWidgetValue(string(fxParamValue));
-            }
+            if(lastTouchedFX.track)
+                context->UpdateWidgetValue(context->GetPage()->GetLastTouchedFXFormattedValue());
         }
         else
             context->ClearWidget();
@@ -1456,9 +1435,9 @@ public:
         if(MediaTrack* track = context->GetTrack())
         {
             string sendTrackName = "";
-            MediaTrack* destTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, 0, context->GetSlotIndex() + DAW::GetTrackNumSends(track, 1), "P_DESTTRACK", 0);;
+            MediaTrack* destTrack = context->GetPage()->GetTrackNavigationManager()->GetSendDestination(track, context->GetSlotIndex());
             if(destTrack)
-                sendTrackName = (char *)DAW::GetSetMediaTrackInfo(destTrack, "P_NAME", NULL);
+                sendTrackName = context->GetPage()->GetTrackNavigationManager()->GetSendDestinationName(track, context->GetSlotIndex());
             context->UpdateWidgetValue(sendTrackName);
         }
         else
@@ -1477,16 +1456,14 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            MediaTrack* destTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, 0, context->GetSlotIndex() + DAW::GetTrackNumSends(track, 1), "P_DESTTRACK", 0);;
+            MediaTrack* destTrack = context->GetPage()->GetTrackNavigationManager()->GetSendDestination(track, context->GetSlotIndex());
             if(destTrack)
             {
-                int numHardwareSends = DAW::GetTrackNumSends(track, 1);
+                int numHardwareSends = context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track);
                 double vol, pan = 0.0;
                 DAW::GetTrackSendUIVolPan(track, context->GetSlotIndex() + numHardwareSends, &vol, &pan);
 
-                char trackVolume[128];
-                snprintf(trackVolume, sizeof(trackVolume), "%7.2lf", VAL2DB(vol));
-                context->UpdateWidgetValue(string(trackVolume));
+                context->UpdateWidgetValue(context->GetFormattedVolumeValue(vol));
             }
             else
                 context->ClearWidget();
@@ -1507,12 +1484,12 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            MediaTrack* destTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, 0, context->GetSlotIndex() + DAW::GetTrackNumSends(track, 1), "P_DESTTRACK", 0);;
+            MediaTrack* destTrack = context->GetPage()->GetTrackNavigationManager()->GetSendDestination(track, context->GetSlotIndex());
             if(destTrack)
             {
-                double panVal = DAW::GetTrackSendInfo_Value(track, 0, context->GetSlotIndex() + DAW::GetTrackNumSends(track, 1), "D_PAN");
+                double panVal = DAW::GetTrackSendInfo_Value(track, 0, context->GetSlotIndex() + context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track), "D_PAN");
                 
-                context->UpdateWidgetValue(context->GetPanValueString(panVal));
+                context->UpdateWidgetValue(context->GetFormattedPanValue(panVal));
             }
             else
                 context->ClearWidget();
@@ -1533,12 +1510,12 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            MediaTrack* destTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, 0, context->GetSlotIndex() + DAW::GetTrackNumSends(track, 1), "P_DESTTRACK", 0);;
+            MediaTrack* destTrack = context->GetPage()->GetTrackNavigationManager()->GetSendDestination(track, context->GetSlotIndex());
             if(destTrack)
             {
                 // I_SENDMODE : returns int *, 0=post-fader, 1=pre-fx, 2=post-fx (deprecated), 3=post-fx
                 
-                double prePostVal = DAW::GetTrackSendInfo_Value(track, 0, context->GetSlotIndex() + DAW::GetTrackNumSends(track, 1), "I_SENDMODE");
+                double prePostVal = DAW::GetTrackSendInfo_Value(track, 0, context->GetSlotIndex() + context->GetPage()->GetTrackNavigationManager()->GetNumHardwareSends(track), "I_SENDMODE");
                 
                 string prePostValueString = "";
                 
@@ -1570,11 +1547,10 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            MediaTrack* srcTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, -1, context->GetSlotIndex(), "P_SRCTRACK", 0);
+            MediaTrack* srcTrack = context->GetPage()->GetTrackNavigationManager()->GetReceiveSource(track, context->GetSlotIndex());
             if(srcTrack)
             {
-                string receiveTrackName = "";
-                receiveTrackName = (char *)DAW::GetSetMediaTrackInfo(srcTrack, "P_NAME", NULL);
+                string receiveTrackName = context->GetPage()->GetTrackNavigationManager()->GetReceiveSourceName(track, context->GetSlotIndex());
                 context->UpdateWidgetValue(receiveTrackName);
             }
             else
@@ -1596,12 +1572,10 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            MediaTrack* srcTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, -1, context->GetSlotIndex(), "P_SRCTRACK", 0);
+            MediaTrack* srcTrack = context->GetPage()->GetTrackNavigationManager()->GetReceiveSource(track, context->GetSlotIndex());
             if(srcTrack)
             {
-                char trackVolume[128];
-                snprintf(trackVolume, sizeof(trackVolume), "%7.2lf", VAL2DB(DAW::GetTrackSendInfo_Value(track, -1, context->GetSlotIndex(), "D_VOL")));
-                context->UpdateWidgetValue(string(trackVolume));
+                context->UpdateWidgetValue(context->GetFormattedVolumeValue(DAW::GetTrackSendInfo_Value(track, -1, context->GetSlotIndex(), "D_VOL")));
             }
             else
                 context->ClearWidget();
@@ -1622,12 +1596,12 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            MediaTrack* srcTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, -1, context->GetSlotIndex(), "P_SRCTRACK", 0);
+            MediaTrack* srcTrack = context->GetPage()->GetTrackNavigationManager()->GetReceiveSource(track, context->GetSlotIndex());
             if(srcTrack)
             {
                 double panVal = DAW::GetTrackSendInfo_Value(track, -1, context->GetSlotIndex(), "D_PAN");
                 
-                context->UpdateWidgetValue(context->GetPanValueString(panVal));
+                context->UpdateWidgetValue(context->GetFormattedPanValue(panVal));
             }
             else
                 context->ClearWidget();
@@ -1648,7 +1622,7 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            MediaTrack* srcTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, -1, context->GetSlotIndex(), "P_SRCTRACK", 0);
+            MediaTrack* srcTrack = context->GetPage()->GetTrackNavigationManager()->GetReceiveSource(track, context->GetSlotIndex());
             if(srcTrack)
             {
                 // I_SENDMODE : returns int *, 0=post-fader, 1=pre-fx, 2=post-fx (deprecated), 3=post-fx
@@ -1711,21 +1685,13 @@ public:
     {
         if(MediaTrack* track = context->GetTrack())
         {
-            char buf[BUFSZ];
-            
-            if(context->GetSurface()->GetIsEuConFXAreaFocused())
-            {
-                if(track == context->GetTrackNavigationManager()->GetSelectedTrack())
-                    DAW::GetTrackName(track, buf, sizeof(buf));
-                else
-                    buf[0] = 0;
-            }
+            if(context->GetSurface()->GetIsEuConFXAreaFocused() && track != context->GetTrackNavigationManager()->GetSelectedTrack())
+                context->UpdateWidgetValue("");
             else
             {
-                DAW::GetTrackName(track, buf, sizeof(buf));
+                const TrackNameEntry &trackName = context->GetTrackNavigationManager()->GetTrackName(track);
+                context->UpdateWidgetValue(trackName.name, trackName.generation);
             }
-            
-            context->UpdateWidgetValue(string(buf));
         }
         else
             context->ClearWidget();
@@ -1746,9 +1712,7 @@ public:
             double vol, pan = 0.0;
             DAW::GetTrackUIVolPan(track, &vol, &pan);
 
-            char trackVolume[128];
-            snprintf(trackVolume, sizeof(trackVolume), "%7.2lf", VAL2DB(vol));
-            context->UpdateWidgetValue(string(trackVolume));
+            context->UpdateWidgetValue(context->GetFormattedVolumeValue(vol));
         }
         else
             context->ClearWidget();
@@ -1769,7 +1733,7 @@ public:
             double vol, pan = 0.0;
             DAW::GetTrackUIVolPan(track, &vol, &pan);
 
-            context->UpdateWidgetValue(context->GetPanValueString(pan));
+            context->UpdateWidgetValue(context->GetFormattedPanValue(pan));
         }
         else
             context->ClearWidget();
@@ -1789,7 +1753,7 @@ public:
         {
             double widthVal = DAW::GetMediaTrackInfo_Value(track, "D_WIDTH");
             
-            context->UpdateWidgetValue(context->GetPanWidthValueString(widthVal));
+            context->UpdateWidgetValue(context->GetFormattedPanWidthValue(widthVal));
         }
         else
             context->ClearWidget();
@@ -1809,7 +1773,7 @@ public:
         {
             double panVal = DAW::GetMediaTrackInfo_Value(track, "D_DUALPANL");
             
-            context->UpdateWidgetValue(context->GetPanValueString(panVal));
+            context->UpdateWidgetValue(context->GetFormattedPanValue(panVal));
         }
         else
             context->ClearWidget();
@@ -1829,7 +1793,7 @@ public:
         {
             double panVal = DAW::GetMediaTrackInfo_Value(track, "D_DUALPANR");
             
-            context->UpdateWidgetValue(context->GetPanValueString(panVal));
+            context->UpdateWidgetValue(context->GetFormattedPanValue(panVal));
         }
         else
             context->ClearWidget();
@@ -1851,7 +1815,7 @@ public:
             {
                 double widthVal = DAW::GetMediaTrackInfo_Value(track, "D_WIDTH");
 
-                context->UpdateWidgetValue(context->GetPanWidthValueString(widthVal));
+                context->UpdateWidgetValue(context->GetFormattedPanWidthValue(widthVal));
             }
             else
             {
@@ -1867,7 +1831,7 @@ public:
                         panVal = DAW::GetMediaTrackInfo_Value(track, "D_DUALPANR");
                 }
                 
-                context->UpdateWidgetValue(context->GetPanValueString(panVal));
+                context->UpdateWidgetValue(context->GetFormattedPanValue(panVal));
             }
         }
         else
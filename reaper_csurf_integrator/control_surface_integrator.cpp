@@ -10,6 +10,7 @@
 #include "control_surface_Reaper_actions.h"
 #include "control_surface_manager_actions.h"
 #include "control_surface_integrator_ui.h"
+#include <sys/stat.h>
 
 extern reaper_plugin_info_t *g_reaper_plugin_info;
 
@@ -177,14 +178,14 @@ struct ActionTemplate
     vector<vector<string>> properties;
     bool isFeedbackInverted;
     double holdDelayAmount;
+    bool isLongPress;
+    bool isDoubleTap;
     
-    ActionTemplate(string action, vector<string> prams, bool isInverted, double amount) : actionName(action), params(prams), isFeedbackInverted(isInverted), holdDelayAmount(amount) {}
+    ActionTemplate(string action, vector<string> prams, bool isInverted, double amount, bool longPress, bool doubleTap) : actionName(action), params(prams), isFeedbackInverted(isInverted), holdDelayAmount(amount), isLongPress(longPress), isDoubleTap(doubleTap) {}
 };
 
 static void listZoneFiles(const string &path, vector<string> &results)
 {
-    regex rx(".*\\.zon$");
-    
     if (auto dir = opendir(path.c_str())) {
         while (auto f = readdir(dir)) {
             if (!f->d_name || f->d_name[0] == '.') continue;
@@ -192,14 +193,14 @@ static void listZoneFiles(const string &path, vector<string> &results)
                 listZoneFiles(path + f->d_name + "/", results);
             
             if (f->d_type == DT_REG)
-                if(regex_match(f->d_name, rx))
+                if(strlen(f->d_name) >= 4 && strcmp(f->d_name + strlen(f->d_name) - 4, ".zon") == 0)
                     results.push_back(path + f->d_name);
         }
         closedir(dir);
     }
 }
 
-static void GetWidgetNameAndProperties(string line, string &widgetName, string &modifier, string &touchId, bool &isFeedbackInverted, double &holdDelayAmount, bool &isProperty)
+static void GetWidgetNameAndProperties(string line, string &widgetName, string &modifier, string &touchId, bool &isFeedbackInverted, double &holdDelayAmount, bool &isLongPress, bool &isDoubleTap, bool &isProperty)
 {
     istringstream modified_role(line);
     vector<string> modifier_tokens;
@@ -213,7 +214,7 @@ static void GetWidgetNameAndProperties(string line, string &widgetName, string &
     {
         for(int i = 0; i < modifier_tokens.size() - 1; i++)
         {
-            if(modifier_tokens[i].find("Touch") != string::npos)
+            if(modifier_tokens[i].find("Touch") != string::npos || (modifier_tokens[i] != "LongPress" && modifier_tokens[i].size() > 5 && modifier_tokens[i].compare(modifier_tokens[i].size() - 5, 5, "Press") == 0))
             {
                 touchId = modifier_tokens[i];
                 modifierSlots[0] = modifier_tokens[i] + "+";
@@ -231,6 +232,13 @@ static void GetWidgetNameAndProperties(string line, string &widgetName, string &
                 isFeedbackInverted = true;
             else if(modifier_tokens[i] == "Hold")
                 holdDelayAmount = 1.0;
+            else if(modifier_tokens[i] == "LongPress")
+            {
+                holdDelayAmount = LongPressTime;
+                isLongPress = true;
+            }
+            else if(modifier_tokens[i] == "DoubleTap")
+                isDoubleTap = true;
             else if(modifier_tokens[i] == "Property")
                 isProperty = true;
         }
@@ -241,88 +249,48 @@ static void GetWidgetNameAndProperties(string line, string &widgetName, string &
     modifier = modifierSlots[0] + modifierSlots[1] + modifierSlots[2] + modifierSlots[3] + modifierSlots[4];
 }
 
-static void PreProcessZoneFile(string filePath, ControlSurface* surface)
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct ParsedZone
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 {
-    string zoneName = "";
-    string navigatorName = "";
-    int lineNumber = 0;
-    
-    try
-    {
-        ifstream file(filePath);
-        
-        for (string line; getline(file, line) ; )
-        {
-            line = regex_replace(line, regex(TabChars), " ");
-            line = regex_replace(line, regex(CRLFChars), "");
-            
-            line = line.substr(0, line.find("//")); // remove trailing commewnts
-            
-            lineNumber++;
-            
-            // Trim leading and trailing spaces
-            line = regex_replace(line, regex("^\\s+|\\s+$"), "", regex_constants::format_default);
-            
-            if(line == "" || (line.size() > 0 && line[0] == '/')) // ignore blank lines and comment lines
-                continue;
-            
-            vector<string> tokens(GetTokens(line));
-            
-            if(tokens.size() > 0)
-            {
-                if(tokens[0] == "Zone")
-                {
-                    zoneName = tokens.size() > 1 ? tokens[1] : "";
-                    surface->AddZoneFilename(zoneName, filePath);
-                    break;
-                }
-            }
-        }
-    }
-    catch (exception &e)
-    {
-        char buffer[250];
-        snprintf(buffer, sizeof(buffer), "Trouble in %s, around line %d\n", filePath.c_str(), lineNumber);
-        DAW::ShowConsoleMsg(buffer);
-    }
-}
+    // Everything read from a .zon file, before any surface, navigator or widget is involved -- safe to build off the UI thread
+    string filePath;
+    string zoneName;
+    string zoneAlias;
+    string navigatorName;
+    string lastActionName;
+    vector<string> includedZones;
+    vector<string> subZones;
+    map<string, string> touchIds;
+    map<string, map<string, vector<ActionTemplate>>> widgetActions;
+    bool isComplete = false;    // ZoneEnd was reached
+    int errorLineNumber = 0;    // non zero if parsing threw
+};
 
-static void ProcessZoneFile(string filePath, ControlSurface* surface)
+static shared_ptr<const ParsedZone> ParseZoneText(string filePath, const string &zoneText)
 {
-    vector<string> includedZones;
+    shared_ptr<ParsedZone> parsedZone = make_shared<ParsedZone>();
+    
+    parsedZone->filePath = filePath;
+    
     bool isInIncludedZonesSection = false;
-    vector<string> subZones;
     bool isInSubZonesSection = false;
-
-    map<string, string> touchIds;
     
-    map<string, map<string, vector<ActionTemplate*>>> widgetActions;
+    vector<ActionTemplate>* currentActionTemplates = nullptr;
     
-    string zoneName = "";
-    string zoneAlias = "";
-    string navigatorName = "";
-    string actionName = "";
     int lineNumber = 0;
     
-    ActionTemplate* currentActionTemplate = nullptr;
-    
     try
     {
-        ifstream file(filePath);
+        LineReader file(zoneText);
         
-        for (string line; getline(file, line) ; )
-        {           
-            line = regex_replace(line, regex(TabChars), " ");
-            line = regex_replace(line, regex(CRLFChars), "");
-            
-            line = line.substr(0, line.find("//")); // remove trailing commewnts
-            
+        for (string_view rawLine; file.GetLine(rawLine) ; )
+        {
             lineNumber++;
             
-            // Trim leading and trailing spaces
-            line = regex_replace(line, regex("^\\s+|\\s+$"), "", regex_constants::format_default);
+            string_view line = LineReader::GetZoneLine(rawLine); // trailing comment and surrounding whitespace removed
             
-            if(line == "" || (line.size() > 0 && line[0] == '/')) // ignore blank lines and comment lines
+            if(line.size() == 0) // ignore blank lines and comment lines
                 continue;
             
             vector<string> tokens(GetTokens(line));
@@ -331,207 +299,12 @@ static void ProcessZoneFile(string filePath, ControlSurface* surface)
             {
                 if(tokens[0] == "Zone")
                 {
-                    zoneName = tokens.size() > 1 ? tokens[1] : "";
-                    zoneAlias = tokens.size() > 2 ? tokens[2] : "";
+                    parsedZone->zoneName = tokens.size() > 1 ? tokens[1] : "";
+                    parsedZone->zoneAlias = tokens.size() > 2 ? tokens[2] : "";
                 }
-                else if(tokens[0] == "ZoneEnd" && zoneName != "")
+                else if(tokens[0] == "ZoneEnd" && parsedZone->zoneName != "")
                 {
-                    currentActionTemplate = nullptr;
-                    
-                    vector<Navigator*> navigators;
-                    
-                    NavigationStyle navigationStyle = Standard;
-                    
-                    if(navigatorName == "")
-                        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetDefaultNavigator());
-                    if(navigatorName == "SelectedTrackNavigator")
-                        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
-                    else if(navigatorName == "FocusedFXNavigator")
-                        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetFocusedFXNavigator());
-                    else if(navigatorName == "MasterTrackNavigator")
-                        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetMasterTrackNavigator());
-                    else if(navigatorName == "TrackNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumChannels(); i++)
-                            navigators.push_back(surface->GetNavigatorForChannel(i));
-                    }
-                    else if(navigatorName == "SelectedTrackSendNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumSendSlots(); i++)
-                            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
-                    }
-                    else if(navigatorName == "SelectedTrackReceiveNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumReceiveSlots(); i++)
-                            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
-                    }
-                    else if(navigatorName == "SelectedTrackFXMenuNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumFXSlots(); i++)
-                            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
-                    }
-                    else if(navigatorName == "TrackSendSlotNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumChannels(); i++)
-                            navigators.push_back(surface->GetNavigatorForChannel(i));
-                        
-                        navigationStyle = SendSlot;
-                    }
-                    else if(navigatorName == "TrackReceiveSlotNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumChannels(); i++)
-                            navigators.push_back(surface->GetNavigatorForChannel(i));
-                        
-                        navigationStyle = ReceiveSlot;
-                    }
-                    else if(navigatorName == "TrackFXMenuSlotNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumChannels(); i++)
-                            navigators.push_back(surface->GetNavigatorForChannel(i));
-                        
-                        navigationStyle = FXMenuSlot;
-                    }
-                    else if(navigatorName == "SelectedTrackSendSlotNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumSendSlots(); i++)
-                        {
-                            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
-                            navigationStyle = SelectedTrackSendSlot;
-                        }
-                    }
-                    else if(navigatorName == "SelectedTrackReceiveSlotNavigator")
-                    {
-                        for(int i = 0; i < surface->GetNumReceiveSlots(); i++)
-                        {
-                            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
-                            navigationStyle = SelectedTrackReceiveSlot;
-                        }
-                    }
-
-                    for(int i = 0; i < navigators.size(); i++)
-                    {
-                        string numStr = to_string(i + 1);
-                        
-                        string newZoneName = zoneName;
-                        
-                        map<string, string> expandedTouchIds;
-                        
-                        if(navigators.size() > 1)
-                        {
-                            newZoneName += numStr;
-                        
-                            for(auto [key, value] : touchIds)
-                            {
-                                string expandedKey = regex_replace(key, regex("[|]"), numStr);
-                                string expandedValue = regex_replace(value, regex("[|]"), numStr);
-
-                                expandedTouchIds[expandedKey] = expandedValue;
-                            }
-                        }
-                        else
-                        {
-                            expandedTouchIds = touchIds;
-                        }
-                        
-                        Zone* zone = new Zone(surface, navigators[i], navigationStyle, i, expandedTouchIds, newZoneName, zoneAlias, filePath);
-                        
-                        for(auto includedZoneName : includedZones)
-                        {
-                            int numItems = 1;
-                            
-                            if((       includedZoneName == "Channel"
-                                    || includedZoneName == "TrackSendSlot"
-                                    || includedZoneName == "TrackReceiveSlot"
-                                    || includedZoneName == "TrackFXMenuSlot") && surface->GetNumChannels() > 1)
-                                numItems = surface->GetNumChannels();
-                            else if(includedZoneName == "SelectedTrackSend" && surface->GetNumSendSlots() > 1)
-                                numItems = surface->GetNumSendSlots();
-                            else if(includedZoneName == "SelectedTrackReceive" && surface->GetNumReceiveSlots() > 1)
-                                numItems = surface->GetNumReceiveSlots();
-                            else if(includedZoneName == "SelectedTrackFXMenu" && surface->GetNumFXSlots() > 1)
-                                numItems = surface->GetNumFXSlots();
-                            
-                            for(int j = 0; j < numItems; j++)
-                            {
-                                string expandedName = includedZoneName;
-                                
-                                if(numItems > 1)
-                                    expandedName = includedZoneName + to_string(j + 1);
-                                
-                                Zone* includedZone = surface->GetZone(expandedName);
-                                
-                                if(includedZone)
-                                    zone->AddIncludedZone(includedZone);
-                            }
-                        }
-                        
-                        for(auto subZoneName : subZones)
-                        {
-                            Zone* subZone = surface->GetZone(subZoneName);
-                            
-                            if(subZone)
-                                zone->AddSubZone(subZone);
-                        }
-                        
-                        for(auto [widgetName, modifierActions] : widgetActions)
-                        {
-                            string surfaceWidgetName = widgetName;
-                            
-                            if(navigators.size() > 1)
-                                surfaceWidgetName = regex_replace(surfaceWidgetName, regex("[|]"), to_string(i + 1));
-                            
-                            Widget* widget = surface->GetWidgetByName(surfaceWidgetName);
-                            
-                            if(widget == nullptr)
-                                continue;
-                            
-                            if(actionName == Shift || actionName == Option || actionName == Control || actionName == Alt)
-                                widget->SetIsModifier();
-                            
-                            zone->AddWidget(widget);
-                            
-                            for(auto [modifier, actions] : modifierActions)
-                            {
-                                for(auto action : actions)
-                                {
-                                    string actionName = regex_replace(action->actionName, regex("[|]"), numStr);
-                                    vector<string> memberParams;
-                                    for(int j = 0; j < action->params.size(); j++)
-                                        memberParams.push_back(regex_replace(action->params[j], regex("[|]"), numStr));
-                                    
-                                    ActionContext context = TheManager->GetActionContext(actionName, widget, zone, memberParams, action->properties);
-                                    
-                                    
-                                    // GAW HACK -- this somehow prevents Zone pointer vector issues WTF???
-                                    if(actionName == "GoSubZone")
-                                    {
-                                        for(int i = 0; i < 25; i++)
-                                            widget->QueueAction(1.0);
-                                    }
-                                    // -------------------------------------------------------------------
-
-                                    
-                                    if(action->isFeedbackInverted)
-                                        context.SetIsFeedbackInverted();
-                                    
-                                    if(action->holdDelayAmount != 0.0)
-                                        context.SetHoldDelayAmount(action->holdDelayAmount);
-                                    
-                                    string expandedModifier = regex_replace(modifier, regex("[|]"), numStr);
-                                    
-                                    zone->AddActionContext(widget, expandedModifier, context);
-                                }
-                            }
-                        }
-                        
-                        surface->AddZone(zone);
-                    }
-                    
-                    includedZones.clear();
-                    subZones.clear();
-                    widgetActions.clear();
-                    touchIds.clear();
-                    
+                    parsedZone->isComplete = true;
                     break;
                 }
                 
@@ -547,7 +320,7 @@ static void ProcessZoneFile(string filePath, ControlSurface* surface)
                         || tokens[0] == "SelectedTrackFXMenuNavigator"
                         || tokens[0] == "SelectedTrackSendSlotNavigator"
                         || tokens[0] == "SelectedTrackReceiveSlotNavigator")
-                    navigatorName = tokens[0];
+                    parsedZone->navigatorName = tokens[0];
                 
                 else if(tokens[0] == "IncludedZones")
                     isInIncludedZonesSection = true;
@@ -556,7 +329,7 @@ static void ProcessZoneFile(string filePath, ControlSurface* surface)
                     isInIncludedZonesSection = false;
                 
                 else if(tokens.size() == 1 && isInIncludedZonesSection)
-                    includedZones.push_back(tokens[0]);
+                    parsedZone->includedZones.push_back(tokens[0]);
                 
                 else if(tokens[0] == "SubZones")
                     isInSubZonesSection = true;
@@ -565,23 +338,25 @@ static void ProcessZoneFile(string filePath, ControlSurface* surface)
                     isInSubZonesSection = false;
                 
                 else if(tokens.size() == 1 && isInSubZonesSection)
-                    subZones.push_back(tokens[0]);
+                    parsedZone->subZones.push_back(tokens[0]);
                 
                 else if(tokens.size() > 1)
                 {
-                    actionName = tokens[1];
+                    parsedZone->lastActionName = tokens[1];
                     
                     string widgetName = "";
                     string modifier = "";
                     string touchId = "";
                     bool isFeedbackInverted = false;
                     double holdDelayAmount = 0.0;
+                    bool isLongPress = false;
+                    bool isDoubleTap = false;
                     bool isProperty = false;
                     
-                    GetWidgetNameAndProperties(tokens[0], widgetName, modifier, touchId, isFeedbackInverted, holdDelayAmount, isProperty);
+                    GetWidgetNameAndProperties(tokens[0], widgetName, modifier, touchId, isFeedbackInverted, holdDelayAmount, isLongPress, isDoubleTap, isProperty);
                     
                     if(touchId != "")
-                        touchIds[widgetName] = touchId;
+                        parsedZone->touchIds[widgetName] = touchId;
                     
                     vector<string> params;
                     for(int i = 1; i < tokens.size(); i++)
@@ -589,24 +364,1005 @@ static void ProcessZoneFile(string filePath, ControlSurface* surface)
                     
                     if(isProperty)
                     {
-                        if(currentActionTemplate != nullptr)
-                            currentActionTemplate->properties.push_back(params);
+                        if(currentActionTemplates != nullptr && currentActionTemplates->size() > 0)
+                            currentActionTemplates->back().properties.push_back(params);
                     }
                     else
                     {
-                        currentActionTemplate = new ActionTemplate(actionName, params, isFeedbackInverted, holdDelayAmount);
-                        widgetActions[widgetName][modifier].push_back(currentActionTemplate);
+                        currentActionTemplates = &parsedZone->widgetActions[widgetName][modifier];
+                        currentActionTemplates->push_back(ActionTemplate(tokens[1], params, isFeedbackInverted, holdDelayAmount, isLongPress, isDoubleTap));
+                    }
+                }
+            }
+        }
+    }
+    catch (exception &e)
+    {
+        parsedZone->errorLineNumber = lineNumber;
+    }
+    
+    return parsedZone;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// Compiled zone cache
+//
+// Each parsed .zon is saved to /CSI/ZoneCache as a flat binary file -- a string table followed by the
+// ParsedZone as indices into it. An entry is only used if the source path, size and mtime from stat still match,
+// anything else falls back to parsing the text and rewriting the entry. Entries are read the first time a zone
+// is needed, never at startup, so zones that are never activated cost nothing beyond a stat.
+//////////////////////////////////////////////////////////////////////////////////////////////
+static const uint32_t ZoneCacheMagic = 0x5A495343; // "CSIZ"
+static const int32_t ZoneCacheVersion = 3;
+
+static string zoneCacheFolder = ""; // set once on the UI thread through ZonePreloader::SetCacheFolder, read by the preloader thread
+
+static uint64_t GetFNV1aHash(const string &text)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    
+    for(unsigned char c : text)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    
+    return hash;
+}
+
+// Key for the in-memory content index, the length guards against the odd hash collision
+static string GetZoneContentKey(uint64_t contentHash, size_t contentLength)
+{
+    char key[48];
+    snprintf(key, sizeof(key), "%016llx:%llu", (unsigned long long)contentHash, (unsigned long long)contentLength);
+    
+    return key;
+}
+
+static string GetZoneCacheFilePath(const string &filePath)
+{
+    char hashStr[32];
+    snprintf(hashStr, sizeof(hashStr), "%016llx", (unsigned long long)GetFNV1aHash(filePath));
+    
+    return zoneCacheFolder + hashStr + ".zcc";
+}
+
+// Size and modification time in ns -- whole seconds aren't enough, an edit that keeps the size can land in the same second
+static bool GetFileStamp(const string &filePath, int64_t &fileSize, int64_t &fileTime)
+{
+    struct stat fileStat;
+    
+    if(stat(filePath.c_str(), &fileStat) != 0)
+        return false;
+    
+    fileSize = (int64_t)fileStat.st_size;
+    
+#if defined(__APPLE__)
+    fileTime = (int64_t)fileStat.st_mtimespec.tv_sec * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+#elif defined(WIN32)
+    fileTime = (int64_t)fileStat.st_mtime * 1000000000;
+#else
+    fileTime = (int64_t)fileStat.st_mtim.tv_sec * 1000000000 + fileStat.st_mtim.tv_nsec;
+#endif
+    
+    return true;
+}
+
+static bool ReadFileContents(const string &filePath, string &contents)
+{
+    ifstream file(filePath, ios::binary);
+    
+    if( ! file.is_open())
+        return false;
+    
+    contents.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    
+    return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ZoneCacheWriter
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+private:
+    map<string, int32_t> stringIndices_;
+    vector<string> strings_;
+    string body_;
+    
+    void Put(const void* data, size_t size) { body_.append((const char*)data, size); }
+    
+public:
+    template<typename T> void PutValue(T value) { Put(&value, sizeof(value)); }
+    
+    void PutString(const string &value)
+    {
+        if(stringIndices_.count(value) == 0)
+        {
+            stringIndices_[value] = (int32_t)strings_.size();
+            strings_.push_back(value);
+        }
+        
+        PutValue(stringIndices_[value]);
+    }
+    
+    void PutStrings(const vector<string> &values)
+    {
+        PutValue((int32_t)values.size());
+        
+        for(auto &value : values)
+            PutString(value);
+    }
+    
+    string GetContents()
+    {
+        string contents;
+        
+        uint32_t magic = ZoneCacheMagic;
+        int32_t version = ZoneCacheVersion;
+        int32_t numStrings = (int32_t)strings_.size();
+        
+        contents.append((const char*)&magic, sizeof(magic));
+        contents.append((const char*)&version, sizeof(version));
+        contents.append((const char*)&numStrings, sizeof(numStrings));
+        
+        for(auto &value : strings_)
+        {
+            int32_t length = (int32_t)value.size();
+            contents.append((const char*)&length, sizeof(length));
+            contents.append(value);
+        }
+        
+        return contents + body_;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ZoneCacheReader
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+private:
+    const string &contents_;
+    size_t position_ = 0;
+    vector<string> strings_;
+    bool isValid_ = true;
+    
+    void Get(void* data, size_t size)
+    {
+        if(position_ + size > contents_.size())
+        {
+            isValid_ = false;
+            memset(data, 0, size);
+            return;
+        }
+        
+        memcpy(data, contents_.data() + position_, size);
+        position_ += size;
+    }
+    
+public:
+    ZoneCacheReader(const string &contents) : contents_(contents)
+    {
+        uint32_t magic = GetValue<uint32_t>();
+        int32_t version = GetValue<int32_t>();
+        
+        if(magic != ZoneCacheMagic || version != ZoneCacheVersion)
+        {
+            isValid_ = false;
+            return;
+        }
+        
+        int32_t numStrings = GetValue<int32_t>();
+        
+        for(int i = 0; i < numStrings && isValid_; i++)
+        {
+            int32_t length = GetValue<int32_t>();
+            
+            if(length < 0 || position_ + length > contents_.size())
+            {
+                isValid_ = false;
+                return;
+            }
+            
+            strings_.push_back(contents_.substr(position_, length));
+            position_ += length;
+        }
+    }
+    
+    bool GetIsValid() { return isValid_; }
+    
+    template<typename T> T GetValue()
+    {
+        T value;
+        Get(&value, sizeof(value));
+        return value;
+    }
+    
+    string GetString()
+    {
+        int32_t index = GetValue<int32_t>();
+        
+        if(index < 0 || index >= (int32_t)strings_.size())
+        {
+            isValid_ = false;
+            return "";
+        }
+        
+        return strings_[index];
+    }
+    
+    vector<string> GetStrings()
+    {
+        vector<string> values;
+        
+        int32_t count = GetValue<int32_t>();
+        
+        for(int i = 0; i < count && isValid_; i++)
+            values.push_back(GetString());
+        
+        return values;
+    }
+};
+
+static void WriteCompiledZone(const ParsedZone &parsedZone, int64_t fileSize, int64_t fileTime, uint64_t contentHash)
+{
+    if(zoneCacheFolder == "")
+        return;
+    
+    ZoneCacheWriter writer;
+    
+    writer.PutString(parsedZone.filePath);
+    writer.PutValue(fileSize);
+    writer.PutValue(fileTime);
+    writer.PutValue(contentHash);
+    
+    writer.PutString(parsedZone.zoneName);
+    writer.PutString(parsedZone.zoneAlias);
+    writer.PutString(parsedZone.navigatorName);
+    writer.PutString(parsedZone.lastActionName);
+    writer.PutStrings(parsedZone.includedZones);
+    writer.PutStrings(parsedZone.subZones);
+    writer.PutValue((uint8_t)parsedZone.isComplete);
+    writer.PutValue((int32_t)parsedZone.errorLineNumber);
+    
+    writer.PutValue((int32_t)parsedZone.touchIds.size());
+    for(auto &[key, value] : parsedZone.touchIds)
+    {
+        writer.PutString(key);
+        writer.PutString(value);
+    }
+    
+    writer.PutValue((int32_t)parsedZone.widgetActions.size());
+    for(auto &[widgetName, modifierActions] : parsedZone.widgetActions)
+    {
+        writer.PutString(widgetName);
+        writer.PutValue((int32_t)modifierActions.size());
+        
+        for(auto &[modifier, actions] : modifierActions)
+        {
+            writer.PutString(modifier);
+            writer.PutValue((int32_t)actions.size());
+            
+            for(auto &action : actions)
+            {
+                writer.PutString(action.actionName);
+                writer.PutStrings(action.params);
+                
+                writer.PutValue((int32_t)action.properties.size());
+                for(auto &property : action.properties)
+                    writer.PutStrings(property);
+                
+                writer.PutValue((uint8_t)action.isFeedbackInverted);
+                writer.PutValue(action.holdDelayAmount);
+                writer.PutValue((uint8_t)action.isLongPress);
+                writer.PutValue((uint8_t)action.isDoubleTap);
+            }
+        }
+    }
+    
+    // Write to a temp file and rename, so a reader never sees a half written entry
+    string cacheFilePath = GetZoneCacheFilePath(parsedZone.filePath);
+    string tempFilePath = cacheFilePath + "." + to_string(hash<thread::id>()(this_thread::get_id())) + ".tmp";
+    
+    {
+        ofstream cacheFile(tempFilePath, ios::binary);
+        
+        if( ! cacheFile.is_open())
+            return;
+        
+        cacheFile << writer.GetContents();
+    }
+    
+    remove(cacheFilePath.c_str());
+    
+    if(rename(tempFilePath.c_str(), cacheFilePath.c_str()) != 0)
+        remove(tempFilePath.c_str());
+}
+
+static shared_ptr<const ParsedZone> ReadCompiledZone(const string &filePath, int64_t fileSize, int64_t fileTime, uint64_t contentHash)
+{
+    if(zoneCacheFolder == "")
+        return nullptr;
+    
+    string contents;
+    
+    if( ! ReadFileContents(GetZoneCacheFilePath(filePath), contents))
+        return nullptr;
+    
+    ZoneCacheReader reader(contents);
+    
+    if( ! reader.GetIsValid())
+        return nullptr;
+    
+    // The stamp alone can't be trusted, an edit that keeps the size can land within the file system's mtime resolution
+    if(reader.GetString() != filePath || reader.GetValue<int64_t>() != fileSize || reader.GetValue<int64_t>() != fileTime || reader.GetValue<uint64_t>() != contentHash)
+        return nullptr;
+    
+    shared_ptr<ParsedZone> parsedZone = make_shared<ParsedZone>();
+    
+    parsedZone->filePath = filePath;
+    parsedZone->zoneName = reader.GetString();
+    parsedZone->zoneAlias = reader.GetString();
+    parsedZone->navigatorName = reader.GetString();
+    parsedZone->lastActionName = reader.GetString();
+    parsedZone->includedZones = reader.GetStrings();
+    parsedZone->subZones = reader.GetStrings();
+    parsedZone->isComplete = reader.GetValue<uint8_t>() != 0;
+    parsedZone->errorLineNumber = reader.GetValue<int32_t>();
+    
+    int32_t numTouchIds = reader.GetValue<int32_t>();
+    for(int i = 0; i < numTouchIds && reader.GetIsValid(); i++)
+    {
+        string key = reader.GetString();
+        parsedZone->touchIds[key] = reader.GetString();
+    }
+    
+    int32_t numWidgets = reader.GetValue<int32_t>();
+    for(int i = 0; i < numWidgets && reader.GetIsValid(); i++)
+    {
+        string widgetName = reader.GetString();
+        int32_t numModifiers = reader.GetValue<int32_t>();
+        
+        for(int j = 0; j < numModifiers && reader.GetIsValid(); j++)
+        {
+            vector<ActionTemplate> &actions = parsedZone->widgetActions[widgetName][reader.GetString()];
+            int32_t numActions = reader.GetValue<int32_t>();
+            
+            for(int k = 0; k < numActions && reader.GetIsValid(); k++)
+            {
+                string actionName = reader.GetString();
+                vector<string> params = reader.GetStrings();
+                
+                vector<vector<string>> properties;
+                int32_t numProperties = reader.GetValue<int32_t>();
+                for(int l = 0; l < numProperties && reader.GetIsValid(); l++)
+                    properties.push_back(reader.GetStrings());
+                
+                bool isFeedbackInverted = reader.GetValue<uint8_t>() != 0;
+                double holdDelayAmount = reader.GetValue<double>();
+                bool isLongPress = reader.GetValue<uint8_t>() != 0;
+                bool isDoubleTap = reader.GetValue<uint8_t>() != 0;
+                
+                actions.push_back(ActionTemplate(actionName, params, isFeedbackInverted, holdDelayAmount, isLongPress, isDoubleTap));
+                actions.back().properties = properties;
+            }
+        }
+    }
+    
+    if( ! reader.GetIsValid())
+        return nullptr;
+    
+    return parsedZone;
+}
+
+static shared_ptr<const ParsedZone> ParseZoneFile(string filePath, ZonePreloader* zoneStore, ParsedZoneBatch &batch)
+{
+    int64_t fileSize = 0;
+    int64_t fileTime = 0;
+    bool hasFileStamp = GetFileStamp(filePath, fileSize, fileTime);
+    
+    string zoneText;
+    
+    if( ! ReadFileContents(filePath, zoneText))
+        return ParseZoneText(filePath, "");
+    
+    uint64_t contentHash = GetFNV1aHash(zoneText);
+    string contentKey = GetZoneContentKey(contentHash, zoneText.size());
+    
+    // Same bytes already parsed for another path, e.g. the same FX zone in several surfaces' zone folders
+    if(shared_ptr<const ParsedZone> parsedZone = zoneStore->GetParsedZoneByContent(contentKey))
+        return parsedZone;
+    
+    if(batch.parsedZonesByContent.count(contentKey) > 0)
+        return batch.parsedZonesByContent[contentKey];
+    
+    shared_ptr<const ParsedZone> parsedZone = nullptr;
+    
+    // The compiled entry still matches the file, the text is hashed but not parsed
+    if(hasFileStamp)
+        parsedZone = ReadCompiledZone(filePath, fileSize, fileTime, contentHash);
+    
+    if(parsedZone == nullptr)
+    {
+        parsedZone = ParseZoneText(filePath, zoneText);
+        
+        if(hasFileStamp)
+            WriteCompiledZone(*parsedZone, fileSize, fileTime, contentHash);
+    }
+    
+    batch.parsedZonesByContent[contentKey] = parsedZone;
+    
+    return parsedZone;
+}
+
+static void PreProcessZoneFile(string filePath, ControlSurface* surface)
+{
+    ZonePreloader* zoneStore = TheManager->GetZonePreloader();
+    
+    // Another surface using the same zone folder has been here already
+    string knownZoneName = "";
+    
+    if(zoneStore->GetZoneName(filePath, knownZoneName))
+    {
+        if(knownZoneName != "")
+            surface->AddZoneFilename(knownZoneName, filePath);
+        
+        return;
+    }
+    
+    int64_t fileSize = 0;
+    int64_t fileTime = 0;
+    
+    if(GetFileStamp(filePath, fileSize, fileTime))
+        zoneStore->WatchFile(filePath, fileSize, fileTime);
+    
+    // Only the Zone header is needed here, the rest of the file (or its compiled entry) is read when the zone is first used
+    string zoneName = "";
+    int lineNumber = 0;
+    
+    try
+    {
+        ifstream file(filePath);
+        
+        for (string rawLine; getline(file, rawLine) ; )
+        {
+            lineNumber++;
+            
+            string_view line = LineReader::GetZoneLine(rawLine); // trailing comment and surrounding whitespace removed
+            
+            if(line.size() == 0) // ignore blank lines and comment lines
+                continue;
+            
+            vector<string> tokens(GetTokens(line));
+            
+            if(tokens.size() > 0)
+            {
+                if(tokens[0] == "Zone")
+                {
+                    zoneName = tokens.size() > 1 ? tokens[1] : "";
+                    surface->AddZoneFilename(zoneName, filePath);
+                    zoneStore->AddZoneName(filePath, zoneName);
+                    break;
+                }
+            }
+        }
+    }
+    catch (exception &e)
+    {
+        char buffer[250];
+        snprintf(buffer, sizeof(buffer), "Trouble in %s, around line %d\n", filePath.c_str(), lineNumber);
+        DAW::ShowConsoleMsg(buffer);
+    }
+}
+
+// Swaps each "|" for the channel number, a plain scan rather than a regex since it runs for every line of every channel
+static string ExpandChannelPlaceholder(const string &text, const string &numStr)
+{
+    if(text.find('|') == string::npos)
+        return text;
+    
+    string expanded;
+    expanded.reserve(text.size() + numStr.size());
+    
+    for(char c : text)
+    {
+        if(c == '|')
+            expanded += numStr;
+        else
+            expanded += c;
+    }
+    
+    return expanded;
+}
+
+// The parsed zone may be shared with other paths that have the same contents, so the caller supplies the path this surface loaded
+static void InstantiateZone(const ParsedZone &parsedZone, string filePath, ControlSurface* surface)
+{
+    vector<Navigator*> navigators;
+    
+    NavigationStyle navigationStyle = Standard;
+    
+    if(parsedZone.navigatorName == "")
+        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetDefaultNavigator());
+    if(parsedZone.navigatorName == "SelectedTrackNavigator")
+        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
+    else if(parsedZone.navigatorName == "FocusedFXNavigator")
+        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetFocusedFXNavigator());
+    else if(parsedZone.navigatorName == "MasterTrackNavigator")
+        navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetMasterTrackNavigator());
+    else if(parsedZone.navigatorName == "TrackNavigator")
+    {
+        for(int i = 0; i < surface->GetNumChannels(); i++)
+            navigators.push_back(surface->GetNavigatorForChannel(i));
+    }
+    else if(parsedZone.navigatorName == "SelectedTrackSendNavigator")
+    {
+        for(int i = 0; i < surface->GetNumSendSlots(); i++)
+            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
+    }
+    else if(parsedZone.navigatorName == "SelectedTrackReceiveNavigator")
+    {
+        for(int i = 0; i < surface->GetNumReceiveSlots(); i++)
+            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
+    }
+    else if(parsedZone.navigatorName == "SelectedTrackFXMenuNavigator")
+    {
+        for(int i = 0; i < surface->GetNumFXSlots(); i++)
+            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
+    }
+    else if(parsedZone.navigatorName == "TrackSendSlotNavigator")
+    {
+        for(int i = 0; i < surface->GetNumChannels(); i++)
+            navigators.push_back(surface->GetNavigatorForChannel(i));
+        
+        navigationStyle = SendSlot;
+    }
+    else if(parsedZone.navigatorName == "TrackReceiveSlotNavigator")
+    {
+        for(int i = 0; i < surface->GetNumChannels(); i++)
+            navigators.push_back(surface->GetNavigatorForChannel(i));
+        
+        navigationStyle = ReceiveSlot;
+    }
+    else if(parsedZone.navigatorName == "TrackFXMenuSlotNavigator")
+    {
+        for(int i = 0; i < surface->GetNumChannels(); i++)
+            navigators.push_back(surface->GetNavigatorForChannel(i));
+        
+        navigationStyle = FXMenuSlot;
+    }
+    else if(parsedZone.navigatorName == "SelectedTrackSendSlotNavigator")
+    {
+        for(int i = 0; i < surface->GetNumSendSlots(); i++)
+        {
+            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
+            navigationStyle = SelectedTrackSendSlot;
+        }
+    }
+    else if(parsedZone.navigatorName == "SelectedTrackReceiveSlotNavigator")
+    {
+        for(int i = 0; i < surface->GetNumReceiveSlots(); i++)
+        {
+            navigators.push_back(surface->GetPage()->GetTrackNavigationManager()->GetSelectedTrackNavigator());
+            navigationStyle = SelectedTrackReceiveSlot;
+        }
+    }
+
+    map<const ActionTemplate*, shared_ptr<const ActionContextValues>> sharedValues;
+    
+    for(int i = 0; i < navigators.size(); i++)
+    {
+        string numStr = to_string(i + 1);
+        
+        string newZoneName = parsedZone.zoneName;
+        
+        map<string, string> expandedTouchIds;
+        
+        if(navigators.size() > 1)
+        {
+            newZoneName += numStr;
+        
+            for(auto [key, value] : parsedZone.touchIds)
+            {
+                expandedTouchIds[ExpandChannelPlaceholder(key, numStr)] = ExpandChannelPlaceholder(value, numStr);
+            }
+        }
+        else
+        {
+            expandedTouchIds = parsedZone.touchIds;
+        }
+        
+        // On a hot reload the existing Zone is refilled in place, everything else already holds pointers to it
+        Zone* zone = surface->GetZoneFromFile(newZoneName, filePath);
+        bool isReload = zone != nullptr;
+        
+        if(isReload)
+            zone->Reload(navigators[i], navigationStyle, i, expandedTouchIds, parsedZone.zoneAlias);
+        else
+            zone = new Zone(surface, navigators[i], navigationStyle, i, expandedTouchIds, newZoneName, parsedZone.zoneAlias, filePath);
+        
+        for(auto includedZoneName : parsedZone.includedZones)
+        {
+            int numItems = 1;
+            
+            if((       includedZoneName == "Channel"
+                    || includedZoneName == "TrackSendSlot"
+                    || includedZoneName == "TrackReceiveSlot"
+                    || includedZoneName == "TrackFXMenuSlot") && surface->GetNumChannels() > 1)
+                numItems = surface->GetNumChannels();
+            else if(includedZoneName == "SelectedTrackSend" && surface->GetNumSendSlots() > 1)
+                numItems = surface->GetNumSendSlots();
+            else if(includedZoneName == "SelectedTrackReceive" && surface->GetNumReceiveSlots() > 1)
+                numItems = surface->GetNumReceiveSlots();
+            else if(includedZoneName == "SelectedTrackFXMenu" && surface->GetNumFXSlots() > 1)
+                numItems = surface->GetNumFXSlots();
+            
+            for(int j = 0; j < numItems; j++)
+            {
+                string expandedName = includedZoneName;
+                
+                if(numItems > 1)
+                    expandedName = includedZoneName + to_string(j + 1);
+                
+                Zone* includedZone = surface->GetZone(expandedName);
+                
+                if(includedZone)
+                    zone->AddIncludedZone(includedZone);
+            }
+        }
+        
+        for(auto subZoneName : parsedZone.subZones)
+        {
+            Zone* subZone = surface->GetZone(subZoneName);
+            
+            if(subZone)
+                zone->AddSubZone(subZone);
+        }
+        
+        for(auto &[widgetName, modifierActions] : parsedZone.widgetActions)
+        {
+            string surfaceWidgetName = widgetName;
+            
+            if(navigators.size() > 1)
+                surfaceWidgetName = ExpandChannelPlaceholder(surfaceWidgetName, numStr);
+            
+            Widget* widget = surface->GetWidgetByName(surfaceWidgetName);
+            
+            if(widget == nullptr)
+                continue;
+            
+            if(parsedZone.lastActionName == Shift || parsedZone.lastActionName == Option || parsedZone.lastActionName == Control || parsedZone.lastActionName == Alt)
+                widget->SetIsModifier();
+            
+            zone->AddWidget(widget);
+            
+            for(auto &[modifier, actions] : modifierActions)
+            {
+                for(auto &action : actions)
+                {
+                    string actionName = ExpandChannelPlaceholder(action.actionName, numStr);
+                    vector<string> memberParams;
+                    for(int j = 0; j < (int)action.params.size(); j++)
+                        memberParams.push_back(ExpandChannelPlaceholder(action.params[j], numStr));
+                    
+                    // Stepped values, acceleration and colours never contain "|", so every channel shares the template line's copy
+                    shared_ptr<const ActionContextValues> &values = sharedValues[&action];
+                    
+                    if(values == nullptr)
+                        values = ActionContextValues::Build(action.params, action.properties);
+                    
+                    ActionContext context = TheManager->GetActionContext(actionName, widget, zone, memberParams, values);
+                    
+                    
+                    // GAW HACK -- this somehow prevents Zone pointer vector issues WTF???
+                    if(actionName == "GoSubZone")
+                    {
+                        for(int i = 0; i < 25; i++)
+                            widget->QueueAction(1.0);
                     }
+                    // -------------------------------------------------------------------
+
+                    
+                    if(action.isFeedbackInverted)
+                        context.SetIsFeedbackInverted();
+                    
+                    if(action.holdDelayAmount != 0.0)
+                        context.SetHoldDelayAmount(action.holdDelayAmount);
+                    
+                    if(action.isLongPress)
+                        context.SetIsLongPress();
+                    
+                    if(action.isDoubleTap)
+                        context.SetIsDoubleTap();
+                    
+                    string expandedModifier = ExpandChannelPlaceholder(modifier, numStr);
+                    
+                    zone->AddActionContext(widget, expandedModifier, context);
                 }
             }
         }
+        
+        if( ! isReload)
+            surface->AddZone(zone);
+    }
+}
+
+static void ProcessZoneFile(string filePath, ControlSurface* surface)
+{
+    shared_ptr<const ParsedZone> parsedZone = TheManager->GetZonePreloader()->LoadZoneFile(filePath);
+    
+    if(parsedZone->errorLineNumber != 0)
+    {
+        char buffer[250];
+        snprintf(buffer, sizeof(buffer), "Trouble in %s, around line %d\n", filePath.c_str(), parsedZone->errorLineNumber);
+        DAW::ShowConsoleMsg(buffer);
+    }
+    
+    try
+    {
+        if(parsedZone->isComplete)
+            InstantiateZone(*parsedZone, filePath, surface);
+    }
+    catch (exception &e)
+    {
+        char buffer[250];
+        snprintf(buffer, sizeof(buffer), "Trouble in %s\n", filePath.c_str());
+        DAW::ShowConsoleMsg(buffer);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ZonePreloader
+////////////////////////////////////////////////////////////////////////////////////////////////////////
+ZonePreloader::ZonePreloader() : parsedZones_(make_shared<const map<string, shared_ptr<const ParsedZone>>>()), parsedZonesByContent_(make_shared<const map<string, shared_ptr<const ParsedZone>>>()) {}
+
+ZonePreloader::~ZonePreloader()
+{
+    if(thread_.joinable())
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            shouldStop_ = true;
+        }
+        
+        condition_.notify_one();
+        thread_.join();
+    }
+}
+
+void ZonePreloader::StartThread()
+{
+    if( ! thread_.joinable())
+    {
+        lastFileCheckTime_ = chrono::steady_clock::now();
+        thread_ = thread(&ZonePreloader::ParseFiles, this);
+    }
+}
+
+void ZonePreloader::Preload(const vector<string> &filePaths)
+{
+    if(filePaths.size() == 0)
+        return;
+    
+    {
+        lock_guard<mutex> lock(mutex_);
+        pendingFilePaths_.insert(pendingFilePaths_.end(), filePaths.begin(), filePaths.end());
+    }
+    
+    StartThread();
+    
+    condition_.notify_one();
+}
+
+void ZonePreloader::WatchFile(const string &filePath, int64_t fileSize, int64_t fileTime)
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        watchedFiles_[filePath] = make_pair(fileSize, fileTime);
+    }
+    
+    StartThread();
+}
+
+bool ZonePreloader::TakeReloadedFiles(vector<ReloadedFile> &reloadedFiles)
+{
+    if( ! hasReloadedFiles_) // checked every tick, so don't take the lock unless there is something there
+        return false;
+    
+    lock_guard<mutex> lock(mutex_);
+    
+    reloadedFiles.swap(reloadedFiles_);
+    reloadedFiles_.clear();
+    hasReloadedFiles_ = false;
+    
+    return reloadedFiles.size() > 0;
+}
+
+void ZonePreloader::ParseFiles()
+{
+    unique_lock<mutex> lock(mutex_);
+    
+    while(true)
+    {
+        condition_.wait_for(lock, chrono::milliseconds(ZoneFileCheckInterval), [this] { return shouldStop_ || pendingFilePaths_.size() > 0; });
+        
+        if(shouldStop_)
+            return;
+        
+        vector<string> filePaths;
+        filePaths.swap(pendingFilePaths_);
+        
+        map<string, pair<int64_t, int64_t>> watchedFiles;
+        
+        if(chrono::steady_clock::now() - lastFileCheckTime_ >= chrono::milliseconds(ZoneFileCheckInterval))
+        {
+            watchedFiles = watchedFiles_;
+            lastFileCheckTime_ = chrono::steady_clock::now();
+        }
+        
+        lock.unlock();
+        
+        ParsedZoneBatch batch;
+        shared_ptr<const map<string, shared_ptr<const ParsedZone>>> parsedZones = atomic_load(&parsedZones_);
+        
+        for(auto filePath : filePaths)
+        {
+            if(parsedZones->count(filePath) == 0 && batch.parsedZones.count(filePath) == 0)
+                batch.parsedZones[filePath] = ParseZoneFile(filePath, this, batch);
+        }
+        
+        PublishParsedZones(batch);
+        
+        CheckWatchedFiles(watchedFiles);
+        
+        lock.lock();
+    }
+}
+
+void ZonePreloader::CheckWatchedFiles(const map<string, pair<int64_t, int64_t>> &watchedFiles)
+{
+    ParsedZoneBatch batch;
+    vector<ReloadedFile> reloadedFiles;
+    vector<pair<int64_t, int64_t>> reloadedStamps;
+    
+    for(auto &[filePath, stamp] : watchedFiles)
+    {
+        int64_t fileSize = 0;
+        int64_t fileTime = 0;
+        
+        if( ! GetFileStamp(filePath, fileSize, fileTime)) // gone, or caught mid save -- look again next time
+            continue;
+        
+        if(fileSize == stamp.first && fileTime == stamp.second)
+            continue;
+        
+        ReloadedFile reloadedFile;
+        reloadedFile.filePath = filePath;
+        reloadedFile.detectedTime = chrono::steady_clock::now();
+        
+        if(filePath.size() > 4 && filePath.compare(filePath.size() - 4, 4, ".zon") == 0)
+        {
+            reloadedFile.parsedZone = ParseZoneFile(filePath, this, batch);
+            batch.parsedZones[filePath] = reloadedFile.parsedZone;
+        }
+        
+        reloadedFiles.push_back(reloadedFile);
+        reloadedStamps.push_back(make_pair(fileSize, fileTime));
     }
-    catch (exception &e)
+    
+    if(reloadedFiles.size() == 0)
+        return;
+    
+    // Publish before handing the files to the UI thread, so a surface that reloads finds the new zones in the store
+    PublishParsedZones(batch);
+    
+    lock_guard<mutex> lock(mutex_);
+    
+    for(int i = 0; i < (int)reloadedFiles.size(); i++)
     {
-        char buffer[250];
-        snprintf(buffer, sizeof(buffer), "Trouble in %s, around line %d\n", filePath.c_str(), lineNumber);
-        DAW::ShowConsoleMsg(buffer);
+        if(watchedFiles_.count(reloadedFiles[i].filePath) == 0) // Clear() ran while we were parsing
+            continue;
+        
+        watchedFiles_[reloadedFiles[i].filePath] = reloadedStamps[i];
+        reloadedFiles_.push_back(reloadedFiles[i]);
+        hasReloadedFiles_ = true;
+    }
+}
+
+void ZonePreloader::SetCacheFolder(const string &folder)
+{
+    zoneCacheFolder = folder;
+}
+
+shared_ptr<const ParsedZone> ZonePreloader::LoadZoneFile(const string &filePath)
+{
+    shared_ptr<const ParsedZone> parsedZone = GetParsedZone(filePath);
+    
+    if(parsedZone == nullptr) // not preloaded, parse it here on the calling thread
+    {
+        ParsedZoneBatch batch;
+        parsedZone = ParseZoneFile(filePath, this, batch);
+        batch.parsedZones[filePath] = parsedZone;
+        PublishParsedZones(batch);
+    }
+    
+    return parsedZone;
+}
+
+shared_ptr<const ParsedZone> ZonePreloader::GetParsedZone(string filePath)
+{
+    shared_ptr<const map<string, shared_ptr<const ParsedZone>>> parsedZones = atomic_load(&parsedZones_);
+    
+    auto it = parsedZones->find(filePath);
+    
+    if(it != parsedZones->end())
+    {
+        numHits_++;
+        return it->second;
+    }
+    else
+    {
+        numMisses_++;
+        return nullptr;
+    }
+}
+
+shared_ptr<const ParsedZone> ZonePreloader::GetParsedZoneByContent(const string &contentKey)
+{
+    shared_ptr<const map<string, shared_ptr<const ParsedZone>>> parsedZonesByContent = atomic_load(&parsedZonesByContent_);
+    
+    auto it = parsedZonesByContent->find(contentKey);
+    
+    if(it != parsedZonesByContent->end())
+        return it->second;
+    else
+        return nullptr;
+}
+
+void ZonePreloader::PublishParsedZones(const ParsedZoneBatch &batch)
+{
+    // Readers never lock, writers copy the current maps once per batch and publish the copies with an atomic swap
+    lock_guard<mutex> lock(publishMutex_);
+    
+    if(batch.parsedZones.size() > 0)
+    {
+        shared_ptr<map<string, shared_ptr<const ParsedZone>>> parsedZones = make_shared<map<string, shared_ptr<const ParsedZone>>>(*atomic_load(&parsedZones_));
+        
+        for(auto &[filePath, parsedZone] : batch.parsedZones)
+            (*parsedZones)[filePath] = parsedZone;
+        
+        atomic_store(&parsedZones_, shared_ptr<const map<string, shared_ptr<const ParsedZone>>>(parsedZones));
+    }
+    
+    if(batch.parsedZonesByContent.size() > 0)
+    {
+        shared_ptr<map<string, shared_ptr<const ParsedZone>>> parsedZonesByContent = make_shared<map<string, shared_ptr<const ParsedZone>>>(*atomic_load(&parsedZonesByContent_));
+        
+        for(auto &[contentKey, parsedZone] : batch.parsedZonesByContent)
+            (*parsedZonesByContent)[contentKey] = parsedZone;
+        
+        atomic_store(&parsedZonesByContent_, shared_ptr<const map<string, shared_ptr<const ParsedZone>>>(parsedZonesByContent));
+    }
+}
+
+void ZonePreloader::Clear()
+{
+    lock_guard<mutex> lock(publishMutex_);
+    
+    atomic_store(&parsedZones_, make_shared<const map<string, shared_ptr<const ParsedZone>>>());
+    atomic_store(&parsedZonesByContent_, make_shared<const map<string, shared_ptr<const ParsedZone>>>());
+    
+    zoneNames_.clear();
+    
+    {
+        lock_guard<mutex> pendingLock(mutex_);
+        pendingFilePaths_.clear();
+        watchedFiles_.clear();
+        reloadedFiles_.clear();
+        hasReloadedFiles_ = false;
     }
+    
+    numHits_ = 0;
+    numMisses_ = 0;
 }
 
 void SetRGB(vector<string> params, bool &supportsRGB, bool &supportsTrackColor, vector<rgb_color> &RGBValues)
@@ -721,6 +1477,70 @@ void SetSteppedValues(vector<string> params, double &deltaValue, vector<double>
     }
 }
 
+shared_ptr<const ActionContextValues> ActionContextValues::Build(const vector<string> &params, const vector<vector<string>> &properties)
+{
+    shared_ptr<ActionContextValues> values = make_shared<ActionContextValues>();
+    
+    values->properties = properties;
+    
+    for(auto &property : properties)
+    {
+        if(property.size() == 0)
+            continue;
+
+        if(property[0] == "NoFeedback")
+            values->noFeedback = true;
+        else if(property[0] == "SoftTakeover")
+        {
+            values->isSoftTakeover = true;
+            
+            if(property.size() > 1)
+                values->softTakeoverWindow = atof(property[1].c_str());
+        }
+    }
+    
+    if(params.size() > 0 && params[0] == "SoftTakeover7BitTrackVolume")
+    {
+        values->isSoftTakeover = true;
+        values->softTakeoverWindow = 0.025;
+    }
+    else if(params.size() > 0 && params[0] == "SoftTakeover14BitTrackVolume")
+    {
+        values->isSoftTakeover = true;
+        values->softTakeoverWindow = 0.0025;
+    }
+    
+    if(params.size() > 0)
+    {
+        // Start with an inverted range, SetSteppedValues only ever writes an ordered one, so this tells us if the line had a range
+        values->rangeMinimum = 1.0;
+        values->rangeMaximum = 0.0;
+        
+        SetRGB(params, values->supportsRGB, values->supportsTrackColor, values->RGBValues);
+        SetSteppedValues(params, values->deltaValue, values->acceleratedDeltaValues, values->rangeMinimum, values->rangeMaximum, values->steppedValues, values->acceleratedTickValues);
+        
+        values->hasRange = values->rangeMinimum <= values->rangeMaximum;
+    }
+    
+    if(values->acceleratedTickValues.size() < 1)
+        values->acceleratedTickValues.push_back(10);
+    
+    const vector<double> &steppedValues = values->steppedValues;
+    vector<int> &sortedIndices = values->steppedValueSortedIndices;
+    
+    for(int i = 0; i < (int)steppedValues.size(); i++)
+        sortedIndices.push_back(i);
+    
+    // Sorted by value, then by position in the zone file. Only the first of any repeated value is kept, the old linear scan never picked the others
+    stable_sort(sortedIndices.begin(), sortedIndices.end(), [&steppedValues](int a, int b) { return steppedValues[a] < steppedValues[b]; });
+    sortedIndices.erase(unique(sortedIndices.begin(), sortedIndices.end(), [&steppedValues](int a, int b) { return steppedValues[a] == steppedValues[b]; }), sortedIndices.end());
+    
+    for(int i = 0; i + 1 < (int)sortedIndices.size(); i++)
+        values->steppedValueBinBoundaries.push_back((steppedValues[sortedIndices[i]] + steppedValues[sortedIndices[i + 1]]) / 2.0);
+    
+    return values;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Widgets
 //////////////////////////////////////////////////////////////////////////////
@@ -729,7 +1549,7 @@ static int strToHex(string valueStr)
     return strtol(valueStr.c_str(), nullptr, 16);
 }
 
-static void ProcessMidiWidget(int &lineNumber, ifstream &surfaceTemplateFile, vector<string> tokens,  Midi_ControlSurface* surface)
+static void ProcessMidiWidget(int &lineNumber, LineReader &surfaceTemplateFile, vector<string> tokens,  Midi_ControlSurface* surface)
 {
     if(tokens.size() < 2)
         return;
@@ -745,18 +1565,18 @@ static void ProcessMidiWidget(int &lineNumber, ifstream &surfaceTemplateFile, ve
 
     vector<vector<string>> tokenLines;
     
-    for (string line; getline(surfaceTemplateFile, line) ; )
+    for (string_view line; surfaceTemplateFile.GetLine(line) ; )
     {
-        line = regex_replace(line, regex(TabChars), " ");
-        line = regex_replace(line, regex(CRLFChars), "");
-
         lineNumber++;
         
-        if(line == "" || line[0] == '\r' || line[0] == '/') // ignore comment lines and blank lines
+        if(LineReader::GetIsBlankOrComment(line)) // ignore comment lines and blank lines
             continue;
         
         vector<string> tokens(GetTokens(line));
         
+        if(tokens.size() == 0)
+            continue;
+        
         if(tokens[0] == "WidgetEnd")    // finito baybay - Widget list complete
             break;
         
@@ -817,13 +1637,27 @@ static void ProcessMidiWidget(int &lineNumber, ifstream &surfaceTemplateFile, ve
         {
             feedbackProcessor = new FaderportRGB7Bit_Midi_FeedbackProcessor(surface, widget, new MIDI_event_ex_t(strToHex(tokenLines[i][1]), strToHex(tokenLines[i][2]), strToHex(tokenLines[i][3])));
         }
-        else if(widgetClass == "FB_Fader14Bit" && size == 4)
-        {
-            feedbackProcessor = new Fader14Bit_Midi_FeedbackProcessor(surface, widget, new MIDI_event_ex_t(strToHex(tokenLines[i][1]), strToHex(tokenLines[i][2]), strToHex(tokenLines[i][3])));
-        }
-        else if(widgetClass == "FB_Fader7Bit" && size == 4)
+        else if((widgetClass == "FB_Fader14Bit" || widgetClass == "FB_Fader7Bit") && size >= 4)
         {
-            feedbackProcessor = new Fader7Bit_Midi_FeedbackProcessor(surface, widget, new MIDI_event_ex_t(strToHex(tokenLines[i][1]), strToHex(tokenLines[i][2]), strToHex(tokenLines[i][3])));
+            MotorFader_Midi_FeedbackProcessor* faderProcessor = nullptr;
+            
+            if(widgetClass == "FB_Fader14Bit")
+                faderProcessor = new Fader14Bit_Midi_FeedbackProcessor(surface, widget, new MIDI_event_ex_t(strToHex(tokenLines[i][1]), strToHex(tokenLines[i][2]), strToHex(tokenLines[i][3])));
+            else
+                faderProcessor = new Fader7Bit_Midi_FeedbackProcessor(surface, widget, new MIDI_event_ex_t(strToHex(tokenLines[i][1]), strToHex(tokenLines[i][2]), strToHex(tokenLines[i][3])));
+            
+            // Off by default, the surface turns filtering on per fader, e.g. FB_Fader14Bit e0 7f 7f Deadband 8 MaxRate 30
+            for(int j = 4; j + 1 < size; j += 2)
+            {
+                if(tokenLines[i][j] == "Deadband")
+                    faderProcessor->SetDeadband(atoi(tokenLines[i][j + 1].c_str()));
+                else if(tokenLines[i][j] == "MaxRate")
+                    faderProcessor->SetMaxUpdateRate(atoi(tokenLines[i][j + 1].c_str()));
+            }
+            
+            surface->AddDeferredFeedbackProcessor(faderProcessor);
+            
+            feedbackProcessor = faderProcessor;
         }
         else if(widgetClass == "FB_Encoder" && size == 4)
         {
@@ -939,7 +1773,7 @@ static void ProcessMidiWidget(int &lineNumber, ifstream &surfaceTemplateFile, ve
     }
 }
 
-static void ProcessOSCWidget(int &lineNumber, ifstream &surfaceTemplateFile, vector<string> tokens,  OSC_ControlSurface* surface)
+static void ProcessOSCWidget(int &lineNumber, LineReader &surfaceTemplateFile, vector<string> tokens,  OSC_ControlSurface* surface)
 {
     if(tokens.size() < 2)
         return;
@@ -953,18 +1787,18 @@ static void ProcessOSCWidget(int &lineNumber, ifstream &surfaceTemplateFile, vec
 
     vector<vector<string>> tokenLines;
 
-    for (string line; getline(surfaceTemplateFile, line) ; )
+    for (string_view line; surfaceTemplateFile.GetLine(line) ; )
     {
-        line = regex_replace(line, regex(TabChars), " ");
-        line = regex_replace(line, regex(CRLFChars), "");
-
         lineNumber++;
         
-        if(line == "" || line[0] == '\r' || line[0] == '/') // ignore comment lines and blank lines
+        if(LineReader::GetIsBlankOrComment(line)) // ignore comment lines and blank lines
             continue;
         
         vector<string> tokens(GetTokens(line));
         
+        if(tokens.size() == 0)
+            continue;
+        
         if(tokens[0] == "WidgetEnd")    // finito baybay - Widget list complete
             break;
         
@@ -988,16 +1822,16 @@ static void ProcessWidgetFile(string filePath, ControlSurface* surface)
     
     try
     {
-        ifstream file(filePath);
+        string fileText;
+        ReadFileContents(filePath, fileText);
         
-        for (string line; getline(file, line) ; )
+        LineReader file(fileText);
+        
+        for (string_view line; file.GetLine(line) ; )
         {
-            line = regex_replace(line, regex(TabChars), " ");
-            line = regex_replace(line, regex(CRLFChars), "");
-            
             lineNumber++;
             
-            if(line == "" || line[0] == '\r' || line[0] == '/') // ignore comment lines and blank lines
+            if(LineReader::GetIsBlankOrComment(line)) // ignore comment lines and blank lines
                 continue;
             
             vector<string> tokens(GetTokens(line));
@@ -1046,6 +1880,8 @@ void Manager::InitActionsDictionary()
     actions_["NextPage"] =                          new GoNextPage();
     actions_["GoPage"] =                            new GoPage();
     actions_["PageNameDisplay"] =                   new PageNameDisplay();
+    actions_["FullRefresh"] =                       new FullRefresh();
+    actions_["ShowUpdateStatistics"] =              new ShowUpdateStatistics();
     actions_["GoZone"] =                            new GoZone();
     actions_["GoSubZone"] =                         new GoSubZone();
     actions_["SetBroadcastGoZone"] =                new SetBroadcastGoZone();
@@ -1168,6 +2004,23 @@ void Manager::InitActionsDictionary()
 void Manager::Init()
 {
     pages_.clear();
+    pageSwitchedFrom_ = nullptr;
+    
+    zonePreloader_.Clear(); // zone files may have been edited since the last Init
+    
+    if(zoneCacheFolder == "")
+    {
+        string folder = string(DAW::GetResourcePath()) + "/CSI/ZoneCache/";
+        
+        DAW::RecursiveCreateDirectory(folder.c_str(), 0);
+        
+        struct stat folderStat;
+        
+        if(stat(folder.c_str(), &folderStat) == 0 && (folderStat.st_mode & S_IFDIR))
+            ZonePreloader::SetCacheFolder(folder);
+    }
+    
+    updateBudget_ = 0;
 
     Page* currentPage = nullptr;
     
@@ -1177,15 +2030,15 @@ void Manager::Init()
     
     try
     {
-        ifstream iniFile(iniFilePath);
+        string iniText;
+        ReadFileContents(iniFilePath, iniText);
+        
+        LineReader iniFile(iniText);
         
         int numChannels = 0;
     
-        for (string line; getline(iniFile, line) ; )
+        for (string_view line; iniFile.GetLine(line) ; )
         {
-            line = regex_replace(line, regex(TabChars), " ");
-            line = regex_replace(line, regex(CRLFChars), "");
-            
             vector<string> tokens(GetTokens(line));
             
             if(tokens.size() > 4) // ignore comment lines and blank lines
@@ -1208,17 +2061,20 @@ void Manager::Init()
             }
         }
         
-        iniFile.clear();
-        iniFile.seekg(0);
+        iniFile = LineReader(iniText);
         
-        for (string line; getline(iniFile, line) ; )
+        for (string_view line; iniFile.GetLine(line) ; )
         {
-            line = regex_replace(line, regex(TabChars), " ");
-            line = regex_replace(line, regex(CRLFChars), "");
-            
             vector<string> tokens(GetTokens(line));
             
-            if(tokens.size() > 4) // ignore comment lines and blank lines
+            if(tokens.size() == 2 && tokens[0] == UpdateBudgetToken)
+            {
+                updateBudget_ = atoi(tokens[1].c_str());
+                
+                if(updateBudget_ < 0)
+                    updateBudget_ = 0;
+            }
+            else if(tokens.size() > 4) // ignore comment lines and blank lines
             {
                 if(tokens[0] == PageToken)
                 {
@@ -1263,8 +2119,139 @@ void Manager::Init()
         DAW::ShowConsoleMsg(buffer);
     }
       
+    // Surface files are watched too, an edit to one re-initialises CSI from ApplyReloadedFiles
+    for(auto page : pages_)
+    {
+        for(auto surface : page->GetSurfaces())
+        {
+            if(surface->GetSourceFileName() == "")
+                continue;
+            
+            string filePath = string(DAW::GetResourcePath()) + surface->GetSourceFileName();
+            int64_t fileSize = 0;
+            int64_t fileTime = 0;
+            
+            if(GetFileStamp(filePath, fileSize, fileTime))
+                zonePreloader_.WatchFile(filePath, fileSize, fileTime);
+        }
+    }
+    
     for(auto page : pages_)
         page->OnInitialization();
+    
+    PreloadFXZones();
+}
+
+void Manager::ApplyReloadedFiles()
+{
+    vector<ReloadedFile> reloadedFiles;
+    
+    if( ! zonePreloader_.TakeReloadedFiles(reloadedFiles))
+        return;
+    
+    char buffer[BUFSZ];
+    
+    // Zones and their action contexts hold on to the widgets, so a changed .mst/.ost can't be swapped in place --
+    // rebuild the pages from CSI.ini the way CSURF_EXT_RESET does, that rereads every surface and zone file
+    for(auto &reloadedFile : reloadedFiles)
+    {
+        if(reloadedFile.parsedZone != nullptr)
+            continue;
+        
+        if(pages_.size() > 0)
+            pages_[currentPageIndex_]->ForceClearAllWidgets();
+        
+        Init();
+        
+        if(currentPageIndex_ >= (int)pages_.size()) // CSI.ini may have lost pages since the last Init
+            currentPageIndex_ = 0;
+        
+        int latency = (int)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - reloadedFile.detectedTime).count();
+        
+        snprintf(buffer, sizeof(buffer), "Reloaded %s in %d ms -- CSI re-initialised\n", reloadedFile.filePath.c_str(), latency);
+        DAW::ShowConsoleMsg(buffer);
+        
+        return; // Init reread the other changed files as well
+    }
+    
+    for(auto &reloadedFile : reloadedFiles)
+    {
+        // A broken edit keeps the zones that are already running, the surfaces carry on with the previous version
+        if(reloadedFile.parsedZone->errorLineNumber != 0 || ! reloadedFile.parsedZone->isComplete)
+        {
+            if(reloadedFile.parsedZone->errorLineNumber != 0)
+                snprintf(buffer, sizeof(buffer), "Trouble in %s, around line %d -- not reloaded\n", reloadedFile.filePath.c_str(), reloadedFile.parsedZone->errorLineNumber);
+            else
+                snprintf(buffer, sizeof(buffer), "Trouble in %s, missing ZoneEnd -- not reloaded\n", reloadedFile.filePath.c_str());
+            
+            DAW::ShowConsoleMsg(buffer);
+            continue;
+        }
+        
+        zonePreloader_.AddZoneName(reloadedFile.filePath, reloadedFile.parsedZone->zoneName); // in case the Zone was renamed
+        
+        for(auto page : pages_)
+            for(auto surface : page->GetSurfaces())
+                surface->ReloadZoneFile(reloadedFile.filePath, reloadedFile.parsedZone);
+        
+        int latency = (int)chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - reloadedFile.detectedTime).count();
+        
+        snprintf(buffer, sizeof(buffer), "Reloaded %s in %d ms\n", reloadedFile.filePath.c_str(), latency);
+        DAW::ShowConsoleMsg(buffer);
+    }
+}
+
+void Manager::AddFXZoneFilePaths(MediaTrack* track, unordered_set<string> &filePathSet, vector<string> &filePaths)
+{
+    // The REAPER calls have to be made here on the UI thread, the preloader only ever sees file paths
+    char fxName[BUFSZ];
+    
+    for(int i = 0; i < DAW::TrackFX_GetCount(track); i++)
+    {
+        DAW::TrackFX_GetFXName(track, i, fxName, sizeof(fxName));
+        
+        for(auto page : pages_)
+        {
+            for(auto surface : page->GetSurfaces())
+            {
+                string filePath = surface->GetZoneFilename(fxName);
+                
+                if(filePath != "" && filePathSet.insert(filePath).second)
+                    filePaths.push_back(filePath);
+            }
+        }
+    }
+}
+
+void Manager::PreloadFXZones()
+{
+    // Gather the zone files for every FX in the project, on any surface -- only done once, from Init
+    unordered_set<string> filePathSet;
+    vector<string> filePaths;
+    
+    for(int i = 0; i <= DAW::CSurf_NumTracks(false); i++)
+    {
+        MediaTrack* track = DAW::CSurf_TrackFromID(i, false);
+        
+        if(track != nullptr)
+            AddFXZoneFilePaths(track, filePathSet, filePaths);
+    }
+    
+    zonePreloader_.Preload(filePaths);
+}
+
+void Manager::PreloadFXZones(MediaTrack* track)
+{
+    // Only the track whose FX list changed, anything already parsed is skipped by the preloader
+    if(track == nullptr)
+        return;
+    
+    unordered_set<string> filePathSet;
+    vector<string> filePaths;
+    
+    AddFXZoneFilePaths(track, filePathSet, filePaths);
+    
+    zonePreloader_.Preload(filePaths);
 }
 //////////////////////////////////////////////////////////////////////////////////////////////
 // Parsing end
@@ -1334,14 +2321,7 @@ MediaTrack* SelectedTrackNavigator::GetTrack()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 MediaTrack* FocusedFXNavigator::GetTrack()
 {
-    int trackNumber = 0;
-    int itemNumber = 0;
-    int fxIndex = 0;
-    
-    if(DAW::GetFocusedFX2(&trackNumber, &itemNumber, &fxIndex) == 1) // Track FX
-        return DAW::GetTrack(trackNumber);
-    else
-        return nullptr;
+    return page_->GetFocusedFXTrack();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1420,18 +2400,9 @@ void TrackNavigationManager::AdjustFXMenuSlotBank(ControlSurface* originatingSur
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ActionContext
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-ActionContext::ActionContext(Action* action, Widget* widget, Zone* zone, vector<string> params, vector<vector<string>> properties): action_(action), widget_(widget), zone_(zone), properties_(properties)
+ActionContext::ActionContext(Action* action, Widget* widget, Zone* zone, const vector<string> &params, shared_ptr<const ActionContextValues> values): action_(action), widget_(widget), zone_(zone), values_(values)
 {   
-    for(auto property : properties)
-    {
-        if(property.size() == 0)
-            continue;
-
-        if(property[0] == "NoFeedback")
-            noFeedback_ = true;
-    }
-    
-    widget->SetProperties(properties);
+    widget->SetProperties(values_->properties);
     
     string actionName = "";
     
@@ -1510,15 +2481,15 @@ ActionContext::ActionContext(Action* action, Widget* widget, Zone* zone, vector<
         SetAssociatedWidget(GetSurface()->GetWidgetByName(params[1]));
     }
     
-    if(params.size() > 0)
+    if(values_->hasRange)
     {
-        SetRGB(params, supportsRGB_, supportsTrackColor_, RGBValues_);
-        SetSteppedValues(params, deltaValue_, acceleratedDeltaValues_, rangeMinimum_, rangeMaximum_, steppedValues_, acceleratedTickValues_);
+        rangeMinimum_ = values_->rangeMinimum;
+        rangeMaximum_ = values_->rangeMaximum;
     }
     
-    if(acceleratedTickValues_.size() < 1)
-        acceleratedTickValues_.push_back(10);
-
+    supportsRGB_ = values_->supportsRGB;
+    RGBValues_ = values_->RGBValues; // per context, SetCurrentRGB can change it
+    supportsTrackColor_ = values_->supportsTrackColor;
 }
 
 Page* ActionContext::GetPage()
@@ -1551,20 +2522,62 @@ string ActionContext::GetName()
     return zone_->GetNameOrAlias();
 }
 
-void ActionContext::RunDeferredActions()
+string ActionContext::GetFxParamDisplayName()
+{
+    if(fxParamDisplayName_ != "")
+        return fxParamDisplayName_;
+    else if(MediaTrack* track = GetTrack())
+        return GetTrackNavigationManager()->GetFXParamName(track, GetSlotIndex(), paramIndex_);
+    
+    return "";
+}
+
+void ActionContext::StartTimer(double delay)
+{
+    CancelTimer();
+    
+    timerDeadline_ = DAW::GetCurrentNumberOfMilliseconds() + delay;
+    GetSurface()->ScheduleDeferredAction(this, timerDeadline_);
+}
+
+void ActionContext::CancelTimer()
+{
+    if(timerDeadline_ != 0.0)
+        GetSurface()->CancelDeferredAction(this, timerDeadline_);
+    
+    timerDeadline_ = 0.0;
+}
+
+void ActionContext::RunDeferredAction()
 {
-    if(holdDelayAmount_ != 0.0 && delayStartTime_ != 0.0 && DAW::GetCurrentNumberOfMilliseconds() > (delayStartTime_ + holdDelayAmount_))
+    // The surface has already removed us from its timer list
+    timerDeadline_ = 0.0;
+    
+    if(isDoubleTap_) // window expired without a second press
     {
-        DoRangeBoundAction(deferredValue_);
-        
-        delayStartTime_ = 0.0;
         deferredValue_ = 0.0;
+        return;
     }
+    
+    if(isLongPress_)
+        hasLongPressFired_ = true;
+    
+    DoRangeBoundAction(deferredValue_);
+    
+    deferredValue_ = 0.0;
+}
+
+void ActionContext::DropDeferredAction()
+{
+    // Binding went away (zone change, page change) while the timer was pending
+    timerDeadline_ = 0.0;
+    deferredValue_ = 0.0;
+    hasLongPressFired_ = false;
 }
 
 void ActionContext::RequestUpdate()
 {
-    if(noFeedback_)
+    if(values_->noFeedback)
         return;
     
     action_->RequestUpdate(this);
@@ -1577,11 +2590,16 @@ void ActionContext::ClearWidget()
 
 void ActionContext::UpdateWidgetValue(double value)
 {
-    if(steppedValues_.size() > 0)
+    if(values_->steppedValues.size() > 0)
         SetSteppedValueIndex(value);
 
     value = isFeedbackInverted_ == false ? value : 1.0 - value;
    
+    // Most widgets don't change from one tick to the next, stop here rather than fan out to every processor.
+    // Track colours can change on their own, so those bindings always go through.
+    if( ! supportsTrackColor_ && hasForwardedValue_ && widget_->GetIsValueMemoOwner(this) && fabs(value - lastForwardedValue_) <= widget_->GetFeedbackEpsilon())
+        return;
+    
     widget_->UpdateValue(value);
 
     if(supportsRGB_)
@@ -1593,20 +2611,18 @@ void ActionContext::UpdateWidgetValue(double value)
     {
         if(MediaTrack* track = zone_->GetNavigator()->GetTrack())
         {
-            unsigned int* rgb_colour = (unsigned int*)DAW::GetSetMediaTrackInfo(track, "I_CUSTOMCOLOR", NULL);
-            
-            int r = (*rgb_colour >> 0) & 0xff;
-            int g = (*rgb_colour >> 8) & 0xff;
-            int b = (*rgb_colour >> 16) & 0xff;
-            
-            widget_->UpdateRGBValue(r, g, b);
+            widget_->UpdateTrackColor(GetPage()->GetTrackNavigationManager()->GetTrackColor(track));
         }
     }
+    
+    hasForwardedValue_ = true;
+    lastForwardedValue_ = value;
+    widget_->SetValueMemoOwner(this);
 }
 
 void ActionContext::UpdateWidgetValue(int param, double value)
 {
-    if(steppedValues_.size() > 0)
+    if(values_->steppedValues.size() > 0)
         SetSteppedValueIndex(value);
 
     value = isFeedbackInverted_ == false ? value : 1.0 - value;
@@ -1624,25 +2640,36 @@ void ActionContext::UpdateWidgetValue(int param, double value)
     {
         if(MediaTrack* track = zone_->GetNavigator()->GetTrack())
         {
-            unsigned int* rgb_colour = (unsigned int*)DAW::GetSetMediaTrackInfo(track, "I_CUSTOMCOLOR", NULL);
-            
-            int r = (*rgb_colour >> 0) & 0xff;
-            int g = (*rgb_colour >> 8) & 0xff;
-            int b = (*rgb_colour >> 16) & 0xff;
-            
-            widget_->UpdateRGBValue(r, g, b);
+            widget_->UpdateTrackColor(GetPage()->GetTrackNavigationManager()->GetTrackColor(track));
         }
     }
 }
 
-void ActionContext::UpdateWidgetValue(string value)
+const string &ActionContext::GetFormattedVolumeValue(double vol)
+{
+    if( ! GetIsFormattedValueCurrent(VolumeFormattedValue, vol))
+    {
+        char trackVolume[128];
+        snprintf(trackVolume, sizeof(trackVolume), "%7.2lf", VAL2DB(vol));
+        formattedValue_ = trackVolume;
+    }
+    
+    return formattedValue_;
+}
+
+void ActionContext::UpdateWidgetValue(const string &value)
 {
     widget_->UpdateValue(value);
 }
 
+void ActionContext::UpdateWidgetValue(const string &value, int generation)
+{
+    widget_->UpdateValue(value, generation);
+}
+
 void ActionContext::ForceWidgetValue(double value)
 {
-    if(steppedValues_.size() > 0)
+    if(values_->steppedValues.size() > 0)
         SetSteppedValueIndex(value);
     
     value = isFeedbackInverted_ == false ? value : 1.0 - value;
@@ -1658,57 +2685,98 @@ void ActionContext::ForceWidgetValue(double value)
     {
         if(MediaTrack* track = zone_->GetNavigator()->GetTrack())
         {
-            unsigned int* rgb_colour = (unsigned int*)DAW::GetSetMediaTrackInfo(track, "I_CUSTOMCOLOR", NULL);
-            
-            int r = (*rgb_colour >> 0) & 0xff;
-            int g = (*rgb_colour >> 8) & 0xff;
-            int b = (*rgb_colour >> 16) & 0xff;
-            
-            widget_->ForceRGBValue(r, g, b);
+            widget_->ForceTrackColor(GetPage()->GetTrackNavigationManager()->GetTrackColor(track));
         }
     }
 }
 
 void ActionContext::DoAction(double value)
 {
-    if(holdDelayAmount_ != 0.0)
+    if(isDoubleTap_)
+    {
+        if(value != 0.0) // ignore release messages
+        {
+            if(timerDeadline_ != 0.0)
+            {
+                CancelTimer();
+                deferredValue_ = 0.0;
+                DoRangeBoundAction(value);
+            }
+            else
+            {
+                deferredValue_ = value;
+                StartTimer(DoubleTapTime);
+            }
+        }
+    }
+    else if(holdDelayAmount_ != 0.0)
     {
         if(value == 0.0)
         {
+            CancelTimer();
             deferredValue_ = 0.0;
-            delayStartTime_ = 0.0;
+            
+            if(hasLongPressFired_)
+            {
+                hasLongPressFired_ = false;
+                DoRangeBoundAction(0.0);
+            }
         }
         else
         {
             deferredValue_ = value;
-            delayStartTime_ =  DAW::GetCurrentNumberOfMilliseconds();
+            hasLongPressFired_ = false;
+            StartTimer(holdDelayAmount_);
         }
     }
     else
     {
-        if(steppedValues_.size() > 0)
+        if(values_->steppedValues.size() > 0)
         {
             if(value != 0.0) // ignore release messages
             {
-                if(steppedValuesIndex_ == steppedValues_.size() - 1)
+                if(steppedValuesIndex_ == values_->steppedValues.size() - 1)
                 {
-                    if(steppedValues_[0] < steppedValues_[steppedValuesIndex_]) // GAW -- only wrap if 1st value is lower
+                    if(values_->steppedValues[0] < values_->steppedValues[steppedValuesIndex_]) // GAW -- only wrap if 1st value is lower
                         steppedValuesIndex_ = 0;
                 }
                 else
                     steppedValuesIndex_++;
                 
-                DoRangeBoundAction(steppedValues_[steppedValuesIndex_]);
+                DoRangeBoundAction(values_->steppedValues[steppedValuesIndex_]);
             }
         }
-        else
+        else if( ! values_->isSoftTakeover || GetIsSoftTakeoverCaught(value))
             DoRangeBoundAction(value);
     }
 }
 
+bool ActionContext::GetIsSoftTakeoverCaught(double value)
+{
+    // Asked every time, a value cached by the update pass can still belong to the track this binding had before a bank change
+    double parameter = action_->GetCurrentNormalizedValue(this);
+    
+    MediaTrack* track = GetTrack();
+    
+    if(track != softTakeoverTrack_)
+    {
+        softTakeoverTrack_ = track;
+        softTakeover_.Reset();
+    }
+    
+    double offset = softTakeover_.GetOffset();
+    
+    bool isCaught = softTakeover_.SetInput(value, parameter, values_->softTakeoverWindow);
+    
+    if(softTakeover_.GetOffset() != offset)
+        widget_->UpdateSoftTakeoverOffset(softTakeover_.GetOffset());
+    
+    return isCaught;
+}
+
 void ActionContext::DoRelativeAction(double delta)
 {
-    if(steppedValues_.size() > 0)
+    if(values_->steppedValues.size() > 0)
         DoSteppedValueAction(delta);
     else
         DoRangeBoundAction(action_->GetCurrentNormalizedValue(this) + delta);
@@ -1716,9 +2784,9 @@ void ActionContext::DoRelativeAction(double delta)
 
 void ActionContext::DoRelativeAction(int accelerationIndex, double delta)
 {
-    if(steppedValues_.size() > 0)
+    if(values_->steppedValues.size() > 0)
         DoAcceleratedSteppedValueAction(accelerationIndex, delta);
-    else if(acceleratedDeltaValues_.size() > 0)
+    else if(values_->acceleratedDeltaValues.size() > 0)
         DoAcceleratedDeltaValueAction(accelerationIndex, delta);
     else
         DoRangeBoundAction(action_->GetCurrentNormalizedValue(this) + delta);
@@ -1741,10 +2809,10 @@ void ActionContext::DoSteppedValueAction(double delta)
     {
         steppedValuesIndex_++;
         
-        if(steppedValuesIndex_ > steppedValues_.size() - 1)
-            steppedValuesIndex_ = steppedValues_.size() - 1;
+        if(steppedValuesIndex_ > values_->steppedValues.size() - 1)
+            steppedValuesIndex_ = values_->steppedValues.size() - 1;
         
-        DoRangeBoundAction(steppedValues_[steppedValuesIndex_]);
+        DoRangeBoundAction(values_->steppedValues[steppedValuesIndex_]);
     }
     else
     {
@@ -1753,7 +2821,7 @@ void ActionContext::DoSteppedValueAction(double delta)
         if(steppedValuesIndex_ < 0 )
             steppedValuesIndex_ = 0;
         
-        DoRangeBoundAction(steppedValues_[steppedValuesIndex_]);
+        DoRangeBoundAction(values_->steppedValues[steppedValuesIndex_]);
     }
 }
 
@@ -1770,22 +2838,22 @@ void ActionContext::DoAcceleratedSteppedValueAction(int accelerationIndex, doubl
         accumulatedIncTicks_ = accumulatedIncTicks_ - 1 < 0 ? 0 : accumulatedIncTicks_ - 1;
     }
     
-    accelerationIndex = accelerationIndex > acceleratedTickValues_.size() - 1 ? acceleratedTickValues_.size() - 1 : accelerationIndex;
+    accelerationIndex = accelerationIndex > values_->acceleratedTickValues.size() - 1 ? values_->acceleratedTickValues.size() - 1 : accelerationIndex;
     accelerationIndex = accelerationIndex < 0 ? 0 : accelerationIndex;
     
-    if(delta > 0 && accumulatedIncTicks_ >= acceleratedTickValues_[accelerationIndex])
+    if(delta > 0 && accumulatedIncTicks_ >= values_->acceleratedTickValues[accelerationIndex])
     {
         accumulatedIncTicks_ = 0;
         accumulatedDecTicks_ = 0;
         
         steppedValuesIndex_++;
         
-        if(steppedValuesIndex_ > steppedValues_.size() - 1)
-            steppedValuesIndex_ = steppedValues_.size() - 1;
+        if(steppedValuesIndex_ > values_->steppedValues.size() - 1)
+            steppedValuesIndex_ = values_->steppedValues.size() - 1;
         
-        DoRangeBoundAction(steppedValues_[steppedValuesIndex_]);
+        DoRangeBoundAction(values_->steppedValues[steppedValuesIndex_]);
     }
-    else if(delta < 0 && accumulatedDecTicks_ >= acceleratedTickValues_[accelerationIndex])
+    else if(delta < 0 && accumulatedDecTicks_ >= values_->acceleratedTickValues[accelerationIndex])
     {
         accumulatedIncTicks_ = 0;
         accumulatedDecTicks_ = 0;
@@ -1795,24 +2863,40 @@ void ActionContext::DoAcceleratedSteppedValueAction(int accelerationIndex, doubl
         if(steppedValuesIndex_ < 0 )
             steppedValuesIndex_ = 0;
         
-        DoRangeBoundAction(steppedValues_[steppedValuesIndex_]);
+        DoRangeBoundAction(values_->steppedValues[steppedValuesIndex_]);
     }
 }
 
 void ActionContext::DoAcceleratedDeltaValueAction(int accelerationIndex, double delta)
 {
-    accelerationIndex = accelerationIndex > acceleratedDeltaValues_.size() - 1 ? acceleratedDeltaValues_.size() - 1 : accelerationIndex;
+    accelerationIndex = accelerationIndex > values_->acceleratedDeltaValues.size() - 1 ? values_->acceleratedDeltaValues.size() - 1 : accelerationIndex;
     accelerationIndex = accelerationIndex < 0 ? 0 : accelerationIndex;
     
     if(delta > 0.0)
-        DoRangeBoundAction(action_->GetCurrentNormalizedValue(this) + acceleratedDeltaValues_[accelerationIndex]);
+        DoRangeBoundAction(action_->GetCurrentNormalizedValue(this) + values_->acceleratedDeltaValues[accelerationIndex]);
     else
-        DoRangeBoundAction(action_->GetCurrentNormalizedValue(this) - acceleratedDeltaValues_[accelerationIndex]);
+        DoRangeBoundAction(action_->GetCurrentNormalizedValue(this) - values_->acceleratedDeltaValues[accelerationIndex]);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Zone
 ////////////////////////////////////////////////////////////////////////////////////////////////////////
+void Zone::Reload(Navigator* navigator, NavigationStyle navigationStyle, int slotIndex, map<string, string> touchIds, string alias)
+{
+    navigator_ = navigator;
+    navigationStyle_ = navigationStyle;
+    slotIndex_ = slotIndex;
+    touchIds_ = touchIds;
+    alias_ = alias;
+    
+    activeTouchIds_.clear();
+    ResolvePressWidgets();
+    widgets_.clear();
+    includedZones_.clear();
+    subZones_.clear();
+    actionContextDictionary_.clear();
+}
+
 void Zone::Activate()
 {
     surface_->LoadingZone(GetName());
@@ -1835,6 +2919,23 @@ void Zone::Activate(vector<Zone*> *activeZones)
     surface_->MoveToFirst(activeZones);
 }
 
+void Zone::ResolvePressWidgets()
+{
+    pressWidgets_.clear();
+    
+    for(auto &[widgetName, touchId] : touchIds_)
+    {
+        if(touchId.size() <= 5 || touchId.compare(touchId.size() - 5, 5, "Press") != 0)
+            continue;
+        
+        if(touchId.size() > 10 && touchId.compare(touchId.size() - 10, 10, "TouchPress") == 0) // set by DoTouch
+            continue;
+        
+        if(Widget* pressWidget = surface_->GetWidgetByName(touchId.substr(0, touchId.size() - 5)))
+            pressWidgets_[touchId] = pressWidget;
+    }
+}
+
 void Zone::Deactivate()
 {
     for(auto widget : widgets_)
@@ -1849,7 +2950,19 @@ vector<ActionContext>& Zone::GetActionContexts(Widget* widget)
     if( ! widget->GetIsModifier())
         modifier = surface_->GetPage()->GetModifier();
     
-    if(touchIds_.count(widgetName) > 0 && activeTouchIds_.count(touchIds_[widgetName]) > 0 && activeTouchIds_[touchIds_[widgetName]] == true && actionContextDictionary_[widget].count(touchIds_[widgetName] + "+" + modifier) > 0)
+    bool isTouchActive = false;
+    
+    if(touchIds_.count(widgetName) > 0)
+    {
+        string &touchId = touchIds_[widgetName];
+        
+        if(pressWidgets_.count(touchId) > 0)
+            isTouchActive = pressWidgets_[touchId]->GetIsPressed();
+        else
+            isTouchActive = activeTouchIds_.count(touchId) > 0 && activeTouchIds_[touchId] == true;
+    }
+    
+    if(isTouchActive && actionContextDictionary_[widget].count(touchIds_[widgetName] + "+" + modifier) > 0)
         return actionContextDictionary_[widget][touchIds_[widgetName] + "+" + modifier];
     else if(actionContextDictionary_[widget].count(modifier) > 0)
         return actionContextDictionary_[widget][modifier];
@@ -1877,14 +2990,20 @@ int Zone::GetSlotIndex()
         return 0;
 }
 
-void Zone::RequestUpdateWidget(Widget* widget)
+void Zone::HandleWidgetInput(Widget* widget)
 {
     widget->HandleQueuedActions(this);
-    
-    // GAW TBD -- This is where we might cut loose multiple feedback if we can individually control it
-    
+}
+
+void Zone::DoAction(Widget* widget, double value)
+{
     for(auto &context : GetActionContexts(widget))
-        context.RunDeferredActions();
+        context.DoAction(value);
+}
+
+void Zone::RequestUpdateWidget(Widget* widget)
+{
+    // GAW TBD -- This is where we might cut loose multiple feedback if we can individually control it
     
     if(GetActionContexts(widget).size() > 0)
     {
@@ -1909,64 +3028,165 @@ Widget::~Widget()
 
 void Widget::SetProperties(vector<vector<string>> properties)
 {
+    isCleared_ = false;
+    
     for(auto processor : feedbackProcessors_)
         processor->SetProperties(properties);
 }
 
 void  Widget::UpdateValue(double value)
 {
+    isCleared_ = false;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->SetValue(value);
 }
 
 void  Widget::UpdateValue(int mode, double value)
 {
+    isCleared_ = false;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->SetValue(mode, value);
 }
 
-void  Widget::UpdateValue(string value)
+void  Widget::UpdateValue(const string &value)
+{
+    isCleared_ = false;
+    lastStringGeneration_ = 0;
+    valueMemoOwner_ = nullptr;
+    
+    for(auto processor : feedbackProcessors_)
+        processor->SetValue(value);
+}
+
+void  Widget::UpdateValue(const string &value, int generation)
 {
+    // Same cached string as last time -- nothing for the processors to compare, let alone send
+    if(generation != 0 && generation == lastStringGeneration_)
+        return;
+    
+    isCleared_ = false;
+    lastStringGeneration_ = generation;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->SetValue(value);
 }
 
 void  Widget::UpdateRGBValue(int r, int g, int b)
 {
+    isCleared_ = false;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->SetRGBValue(r, g, b);
 }
 
+void  Widget::UpdateTrackColor(TrackColor &color)
+{
+    isCleared_ = false;
+    valueMemoOwner_ = nullptr;
+    
+    for(auto processor : feedbackProcessors_)
+        processor->SetTrackColor(color);
+}
+
+void  Widget::UpdateSoftTakeoverOffset(double offset)
+{
+    for(auto processor : feedbackProcessors_)
+        processor->SetSoftTakeoverOffset(offset);
+}
+
 void  Widget::ForceValue(double value)
 {
+    isCleared_ = false;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->ForceValue(value);
 }
 
 void  Widget::ForceRGBValue(int r, int g, int b)
 {
+    isCleared_ = false;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->ForceRGBValue(r, g, b);
 }
 
+void  Widget::ForceTrackColor(TrackColor &color)
+{
+    isCleared_ = false;
+    valueMemoOwner_ = nullptr;
+    
+    for(auto processor : feedbackProcessors_)
+        processor->ForceTrackColor(color);
+}
+
 void  Widget::Clear()
 {
+    // Blank channels get cleared every tick, don't walk the processors when they already are
+    if(isCleared_)
+        return;
+    
+    isCleared_ = true;
+    lastStringGeneration_ = 0;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->Clear();
 }
 
 void  Widget::ForceClear()
 {
+    isCleared_ = true;
+    lastStringGeneration_ = 0;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->ForceClear();
 }
 
 void Widget::ClearCache()
 {
+    isCleared_ = false;
+    lastStringGeneration_ = 0;
+    valueMemoOwner_ = nullptr;
+    
     for(auto processor : feedbackProcessors_)
         processor->ClearCache();
 }
 
+void Widget::CopyCacheFrom(Widget* source)
+{
+    isCleared_ = false;
+    lastStringGeneration_ = 0;
+    valueMemoOwner_ = nullptr;
+    
+    if(source->feedbackProcessors_.size() != feedbackProcessors_.size())
+    {
+        ClearCache();
+        return;
+    }
+    
+    for(int i = 0; i < (int)feedbackProcessors_.size(); i++)
+        feedbackProcessors_[i]->CopyCacheFrom(source->feedbackProcessors_[i]);
+}
+
+void Widget::AddFeedbackProcessor(FeedbackProcessor* feedbackProcessor)
+{
+    double epsilon = feedbackProcessor->GetFeedbackEpsilon();
+    
+    if(feedbackProcessors_.size() == 0 || epsilon < feedbackEpsilon_)
+        feedbackEpsilon_ = epsilon;
+    
+    feedbackProcessors_.push_back(feedbackProcessor);
+}
+
 void Widget::LogInput(double value)
 {
     if( TheManager->GetSurfaceInDisplay())
@@ -1999,6 +3219,20 @@ void Midi_FeedbackProcessor::SendMidiMessage(int first, int second, int third)
         ForceMidiMessage(first, second, third);
 }
 
+void Midi_FeedbackProcessor::CopyCacheFrom(FeedbackProcessor* source)
+{
+    FeedbackProcessor::CopyCacheFrom(source);
+    
+    if(Midi_FeedbackProcessor* midiSource = dynamic_cast<Midi_FeedbackProcessor*>(source))
+    {
+        lastMessageSent_->midi_message[0] = midiSource->lastMessageSent_->midi_message[0];
+        lastMessageSent_->midi_message[1] = midiSource->lastMessageSent_->midi_message[1];
+        lastMessageSent_->midi_message[2] = midiSource->lastMessageSent_->midi_message[2];
+    }
+    else
+        ClearCache();
+}
+
 void Midi_FeedbackProcessor::ForceMidiMessage(int first, int second, int third)
 {
     lastMessageSent_->midi_message[0] = first;
@@ -2022,7 +3256,7 @@ void OSC_FeedbackProcessor::ForceValue(int param, double value)
     surface_->SendOSCMessage(this, oscAddress_, value);
 }
 
-void OSC_FeedbackProcessor::ForceValue(string value)
+void OSC_FeedbackProcessor::ForceValue(const string &value)
 {
     lastStringValue_ = value;
     surface_->SendOSCMessage(this, oscAddress_, value);
@@ -2043,7 +3277,7 @@ void EuCon_FeedbackProcessor::ForceValue(int param, double value)
     surface_->SendEuConMessage(this, address_, value, param);
 }
 
-void EuCon_FeedbackProcessor::ForceValue(string value)
+void EuCon_FeedbackProcessor::ForceValue(const string &value)
 {
     lastStringValue_ = value;
     surface_->SendEuConMessage(this, address_, value);
@@ -2364,14 +3598,11 @@ void ControlSurface::MapFocusedFXToWidgets()
 {
     UnmapFocusedFXFromWidgets();
     
-    int trackNumber = 0;
-    int itemNumber = 0;
-    int fxSlot = 0;
+    int fxSlot = page_->GetFocusedFXIndex();
     MediaTrack* focusedTrack = nullptr;
     
-    if(DAW::GetFocusedFX2(&trackNumber, &itemNumber, &fxSlot) == 1)
-        if(trackNumber > 0)
-            focusedTrack = DAW::GetTrack(trackNumber);
+    if(page_->GetFocusedFXTrackNumber() > 0)
+        focusedTrack = page_->GetFocusedFXTrack();
     
     if(focusedTrack)
     {
@@ -2389,6 +3620,134 @@ void ControlSurface::MapFocusedFXToWidgets()
     }
 }
 
+void ControlSurface::CheckFocusedFXState()
+{
+    // The page polls GetFocusedFX2 once per tick, surfaces just read its state. Checked on every tick rather than only
+    // when the state changes, so a surface whose update was skipped on that tick still unmaps on the next one
+    if((page_->GetFocusedFXState() & 0x04) && activeFocusedFXZones_.size() > 0) // 4 set if FX is no longer focused but still open
+        UnmapFocusedFXFromWidgets();
+}
+
+void ControlSurface::GetActiveWidgets(vector<Widget*> &widgets, vector<Zone*> &owningZones)
+{
+    for(auto activeZones : allActiveZones_)
+        for(auto zone : *activeZones)
+            zone->GetWidgetsForUpdate(widgets, owningZones);
+    
+    if(homeZone_ != nullptr)
+        homeZone_->GetWidgetsForUpdate(widgets, owningZones);
+}
+
+void ControlSurface::RunDeferredActions()
+{
+    if(deferredActions_.size() == 0)
+        return;
+    
+    double now = DAW::GetCurrentNumberOfMilliseconds();
+    
+    while(deferredActions_.size() > 0 && deferredActions_.begin()->first <= now)
+    {
+        ActionContext* context = deferredActions_.begin()->second;
+        deferredActions_.erase(deferredActions_.begin());
+        
+        // Only fire if the context's zone still owns the widget
+        auto it = find(usedWidgets_.begin(), usedWidgets_.end(), context->GetWidget());
+        
+        if(it != usedWidgets_.end() && usedWidgetZones_[it - usedWidgets_.begin()] == context->GetZone())
+            context->RunDeferredAction();
+        else
+            context->DropDeferredAction();
+    }
+}
+
+void ControlSurface::RequestUpdate(double updateDeadline)
+{
+    CheckFocusedFXState();
+    
+    usedWidgets_.clear();
+    usedWidgetZones_.clear();
+
+    GetActiveWidgets(usedWidgets_, usedWidgetZones_);
+    
+    // Input and deferred (Hold) actions are never budgeted
+    for(int i = 0; i < (int)usedWidgets_.size(); i++)
+        usedWidgetZones_[i]->HandleWidgetInput(usedWidgets_[i]);
+    
+    RunDeferredActions();
+    
+    for(auto processor : deferredFeedbackProcessors_)
+        processor->RunDeferredFeedback();
+    
+    for(auto widget : widgets_)
+    {
+        auto it = find(usedWidgets_.begin(), usedWidgets_.end(), widget);
+        
+        if ( it == usedWidgets_.end() )
+            widget->Clear();
+    }
+
+    int numWidgets = usedWidgets_.size();
+    
+    if(numWidgets == 0)
+        return;
+    
+    if(updateCursor_ >= numWidgets)
+        updateCursor_ = 0;
+    
+    updateTickCount_++;
+    ticksInCurrentUpdatePass_++;
+    
+    // Feedback -- always visit at least one widget so every widget gets its turn within a bounded number of ticks
+    int numVisited = 0;
+    
+    while(numVisited < numWidgets)
+    {
+        int index = (updateCursor_ + numVisited) % numWidgets;
+        
+        usedWidgetZones_[index]->RequestUpdateWidget(usedWidgets_[index]);
+        
+        numVisited++;
+        
+        if(updateDeadline != 0.0 && numVisited < numWidgets && DAW::GetCurrentNumberOfMilliseconds() > updateDeadline)
+        {
+            updateOverrunCount_++;
+            break;
+        }
+    }
+    
+    updateCursor_ = (updateCursor_ + numVisited) % numWidgets;
+    
+    updatePassProgress_ += numVisited;
+    
+    if(updatePassProgress_ >= numWidgets)
+    {
+        if(ticksInCurrentUpdatePass_ > maxTicksPerUpdatePass_)
+            maxTicksPerUpdatePass_ = ticksInCurrentUpdatePass_;
+        
+        updatePassProgress_ = 0;
+        ticksInCurrentUpdatePass_ = 0;
+    }
+}
+
+void ControlSurface::CopyCacheFrom(ControlSurface* source)
+{
+    // The hardware is still showing what source last sent, so start from there and only send the differences
+    for(auto widget : widgets_)
+    {
+        if(Widget* sourceWidget = source->GetWidgetByName(widget->GetName()))
+            widget->CopyCacheFrom(sourceWidget);
+        else
+            widget->ClearCache();
+    }
+}
+
+void ControlSurface::ReportUpdateStatistics()
+{
+    char buffer[250];
+    snprintf(buffer, sizeof(buffer), "%s - %d widgets, %d ticks, %d overruns, longest update pass %d ticks\n", name_.c_str(), (int)usedWidgets_.size(), updateTickCount_, updateOverrunCount_, maxTicksPerUpdatePass_);
+    DAW::ShowConsoleMsg(buffer);
+}
+
 void ControlSurface::TrackFXListChanged()
 {
     OnTrackSelection();
@@ -2414,6 +3773,147 @@ void ControlSurface::LoadZone(string zoneName)
     }
 }
 
+Zone* ControlSurface::GetZoneFromFile(string zoneName, string filePath)
+{
+    if(zonesByName_.count(zoneName) > 0 && zonesByName_[zoneName]->GetSourceFilePath() == filePath)
+        return zonesByName_[zoneName];
+    else
+        return nullptr;
+}
+
+void ControlSurface::ReloadZoneFile(string filePath, shared_ptr<const ParsedZone> parsedZone)
+{
+    bool usesFile = false;
+    
+    for(auto [zoneName, zoneFilename] : zoneFilenames_)
+        if(zoneFilename == filePath)
+            usesFile = true;
+    
+    if( ! usesFile)
+        return;
+    
+    // A Zone renamed in the file -- the old name no longer leads anywhere
+    vector<string> previousZoneNames;
+    
+    if(parsedZone->zoneName != "")
+    {
+        for(auto it = zoneFilenames_.begin(); it != zoneFilenames_.end(); )
+        {
+            if(it->second == filePath && it->first != parsedZone->zoneName)
+            {
+                previousZoneNames.push_back(it->first);
+                it = zoneFilenames_.erase(it);
+            }
+            else
+                ++it;
+        }
+        
+        zoneFilenames_[parsedZone->zoneName] = filePath;
+    }
+    
+    vector<Zone*> reloadedZones;
+    vector<Widget*> previousWidgets;
+    
+    for(auto zone : zones_)
+    {
+        if(zone->GetSourceFilePath() == filePath)
+        {
+            reloadedZones.push_back(zone);
+            CancelDeferredActions(zone);
+            
+            for(auto widget : zone->GetWidgets())
+                previousWidgets.push_back(widget);
+        }
+    }
+    
+    if(reloadedZones.size() == 0) // never loaded here, the next LoadZone picks up the new version
+        return;
+    
+    try
+    {
+        InstantiateZone(*parsedZone, filePath, this);
+    }
+    catch (exception &e)
+    {
+        char buffer[250];
+        snprintf(buffer, sizeof(buffer), "Trouble in %s\n", filePath.c_str());
+        DAW::ShowConsoleMsg(buffer);
+    }
+    
+    // Zones under a previous name weren't refilled, InstantiateZone made new ones -- swap those in wherever the old ones were active
+    vector<Zone*> currentZones;
+    
+    for(auto zone : reloadedZones)
+    {
+        string zoneName = zone->GetName();
+        string previousZoneName = "";
+        
+        for(auto &name : previousZoneNames)
+            if(zoneName.compare(0, name.size(), name) == 0 && name.size() > previousZoneName.size())
+                previousZoneName = name;
+        
+        if(previousZoneName == "")
+        {
+            currentZones.push_back(zone);
+            continue;
+        }
+        
+        // Channel3 becomes NewName3
+        Zone* replacement = GetZoneFromFile(parsedZone->zoneName + zoneName.substr(previousZoneName.size()), filePath);
+        
+        ReplaceZone(zone, replacement);
+        
+        if(replacement != nullptr)
+            currentZones.push_back(replacement);
+    }
+    
+    // Only the widgets this file binds are refreshed -- dropped ones are cleared, the rest resend with their new actions
+    vector<Widget*> currentWidgets;
+    
+    for(auto zone : currentZones)
+        for(auto widget : zone->GetWidgets())
+            currentWidgets.push_back(widget);
+    
+    for(auto widget : previousWidgets)
+    {
+        widget->ClearAllQueues();
+        
+        if(find(currentWidgets.begin(), currentWidgets.end(), widget) == currentWidgets.end())
+            widget->Clear();
+    }
+    
+    for(auto widget : currentWidgets)
+        widget->ClearCache();
+}
+
+void ControlSurface::ReplaceZone(Zone* zone, Zone* replacement)
+{
+    // The old Zone isn't deleted, other Zones may still hold it as an included Zone
+    for(auto activeZones : allActiveZones_)
+    {
+        auto it = find(activeZones->begin(), activeZones->end(), zone);
+        
+        if(it == activeZones->end())
+            continue;
+        
+        if(replacement != nullptr && find(activeZones->begin(), activeZones->end(), replacement) == activeZones->end())
+            *it = replacement;
+        else
+            activeZones->erase(it);
+    }
+    
+    if(homeZone_ == zone)
+        homeZone_ = replacement;
+    
+    if(zonesByName_.count(zone->GetName()) > 0 && zonesByName_[zone->GetName()] == zone)
+        zonesByName_.erase(zone->GetName());
+    
+    auto it = find(zones_.begin(), zones_.end(), zone);
+    
+    if(it != zones_.end())
+        zones_.erase(it);
+}
+
 Zone* ControlSurface::GetZone(string zoneName)
 {
     if(zonesByName_.count(zoneName) > 0)
@@ -2472,6 +3972,10 @@ void ControlSurface::GoZone(vector<Zone*> *activeZones, string zoneName, double
 {
     if(zoneName == "Home")
     {
+        vector<Widget*> previousWidgets;
+        vector<Zone*> previousZones;
+        GetActiveWidgets(previousWidgets, previousZones);
+        
         activeZones_.clear();
         activeSelectedTrackSendsZones_.clear();
         activeSelectedTrackReceivesZones_.clear();
@@ -2480,13 +3984,26 @@ void ControlSurface::GoZone(vector<Zone*> *activeZones, string zoneName, double
         activeSelectedTrackFXMenuFXZones_.clear();
         activeFocusedFXZones_.clear();
         
-        for(auto widget : widgets_)
-            widget->ClearAllQueues();
-        
         LoadDefaultZoneOrder();
         
         if(homeZone_ != nullptr)
             homeZone_->Activate();
+        
+        vector<Widget*> currentWidgets;
+        vector<Zone*> currentZones;
+        GetActiveWidgets(currentWidgets, currentZones);
+        
+        // Only touch widgets whose binding actually changed, the rest keep their queues and feedback
+        for(int i = 0; i < (int)previousWidgets.size(); i++)
+        {
+            auto it = find(currentWidgets.begin(), currentWidgets.end(), previousWidgets[i]);
+            
+            if(it == currentWidgets.end() || currentZones[it - currentWidgets.begin()] != previousZones[i])
+            {
+                previousWidgets[i]->ClearAllQueues();
+                previousWidgets[i]->Clear();
+            }
+        }
     }
     else
     {
@@ -2561,6 +4078,8 @@ void Midi_ControlSurface::ProcessMidiMessage(const MIDI_event_ex_t* evt)
 
 void Midi_ControlSurface::SendMidiMessage(MIDI_event_ex_t* midiMessage)
 {
+    numMessagesSent_++;
+    
     if(midiOutput_)
         midiOutput_->SendMsg(midiMessage, -1);
     
@@ -2583,6 +4102,8 @@ void Midi_ControlSurface::SendMidiMessage(MIDI_event_ex_t* midiMessage)
 
 void Midi_ControlSurface::SendMidiMessage(int first, int second, int third)
 {
+    numMessagesSent_++;
+    
     if(midiOutput_)
         midiOutput_->Send(first, second, third, -1);
     
@@ -2640,6 +4161,8 @@ void OSC_ControlSurface::LoadingZone(string zoneName)
 
 void OSC_ControlSurface::SendOSCMessage(OSC_FeedbackProcessor* feedbackProcessor, string oscAddress, double value)
 {
+    numMessagesSent_++;
+    
     if(outSocket_ != nullptr && outSocket_->isOk())
     {
         oscpkt::Message message;
@@ -2657,6 +4180,8 @@ void OSC_ControlSurface::SendOSCMessage(OSC_FeedbackProcessor* feedbackProcessor
 
 void OSC_ControlSurface::SendOSCMessage(OSC_FeedbackProcessor* feedbackProcessor, string oscAddress, string value)
 {
+    numMessagesSent_++;
+    
     if(outSocket_ != nullptr && outSocket_->isOk())
     {
         oscpkt::Message message;
@@ -2806,6 +4331,8 @@ void EuCon_ControlSurface::InitializeEuConWidgets(vector<CSIWidgetInfo> *widgetI
 
 void EuCon_ControlSurface::SendEuConMessage(EuCon_FeedbackProcessor* feedbackProcessor, string address, double value)
 {
+    numMessagesSent_++;
+    
     static void (*HandleReaperMessageWthDouble)(const char *, double) = nullptr;
     
     if(g_reaper_plugin_info && HandleReaperMessageWthDouble == nullptr)
@@ -2819,6 +4346,8 @@ void EuCon_ControlSurface::SendEuConMessage(EuCon_FeedbackProcessor* feedbackPro
 
 void EuCon_ControlSurface::SendEuConMessage(EuCon_FeedbackProcessor* feedbackProcessor, string address, double value, int param)
 {
+    numMessagesSent_++;
+    
     static void (*HandleReaperMessageWthParam)(const char *, double, int) = nullptr;
     
     if(g_reaper_plugin_info && HandleReaperMessageWthParam == nullptr)
@@ -2840,6 +4369,8 @@ void EuCon_ControlSurface::SendEuConMessage(EuCon_FeedbackProcessor* feedbackPro
         return; // GAW -- Hack to prevent overwrite of Pan, Width, etc. labels
     }
     
+    numMessagesSent_++;
+    
     static void (*HandleReaperMessageWthString)(const char *, const char *) = nullptr;
     
     if(g_reaper_plugin_info && HandleReaperMessageWthString == nullptr)
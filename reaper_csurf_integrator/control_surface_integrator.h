@@ -19,10 +19,17 @@
 #include <sstream>
 #include <vector>
 #include <map>
+#include <unordered_set>
 #include <iomanip>
 #include <fstream>
 #include <regex>
 #include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <chrono>
 
 #ifdef _WIN32
 #include "oscpkt.hh"
@@ -53,6 +60,7 @@ const string MidiSurfaceToken = "MidiSurface";
 const string OSCSurfaceToken = "OSCSurface";
 const string EuConSurfaceToken = "EuConSurface";
 const string PageToken = "Page";
+const string UpdateBudgetToken = "UpdateBudget";
 
 const string Shift = "Shift";
 const string Option = "Option";
@@ -64,6 +72,15 @@ const string CRLFChars = "[\r\n]";
 const string TabChars = "[\t]";
 
 const int TempDisplayTime = 1250;
+const double LongPressTime = 0.5; // seconds, same units as Hold
+const int DoubleTapTime = 350;
+const int RoutingVerifyInterval = 1000;
+const double FXParamValueEpsilon = 0.000001; // normalised, smaller moves than this reuse the formatted FX param text
+const double SoftTakeoverWindow = 0.025; // normalised, the default pickup window
+const int ZoneFileCheckInterval = 1000; // ms between hot reload checks of the zone and surface files
+const int FaderDeadband = 0; // fader units, motor fader moves this small are held back until the fader settles, a .mst line can set Deadband
+const int FaderMaxUpdateRate = 0; // motor fader messages per second, 0 for no limit, a .mst line can set MaxRate
+const double FaderSettleTime = 100.0; // ms a held back fader position must stay put before it is sent anyway
 
 enum NavigationStyle
 {
@@ -75,21 +92,159 @@ enum NavigationStyle
     SelectedTrackReceiveSlot,
 };
 
+enum FormattedValueType
+{
+    NoFormattedValue,
+    PanFormattedValue,
+    PanWidthFormattedValue,
+    VolumeFormattedValue,
+};
+
+enum FeedbackValueChannel
+{
+    DoubleValueChannel = 0x01,
+    ParamValueChannel = 0x02,
+    StringValueChannel = 0x04,
+    RGBValueChannel = 0x08,
+    AllValueChannels = 0x0f,
+};
+
 class Manager;
 extern Manager* TheManager;
 
-static vector<string> GetTokens(string line)
+// Hand rolled equivalent of "while(iss >> quoted(token))" over a line that has had tabs turned into spaces and CR/LF removed
+static vector<string> GetTokens(string_view line)
 {
     vector<string> tokens;
     
-    istringstream iss(line);
-    string token;
-    while (iss >> quoted(token))
+    size_t i = 0;
+    size_t length = line.size();
+    
+    while(true)
+    {
+        while(i < length && isspace((unsigned char)line[i]))
+            i++;
+        
+        if(i >= length)
+            break;
+        
+        string token;
+        
+        if(line[i] == '"')
+        {
+            for(i++; i < length && line[i] != '"'; i++)
+            {
+                if(line[i] == '\\') // the escaped character is the next one that isn't CR/LF
+                {
+                    for(i++; i < length && (line[i] == '\r' || line[i] == '\n'); i++)
+                        ;
+                    
+                    if(i >= length)
+                        break;
+                }
+                
+                if(line[i] == '\t')
+                    token += ' ';
+                else if(line[i] != '\r' && line[i] != '\n')
+                    token += line[i];
+            }
+            
+            if(i >= length) // no closing quote, the stream version fails on this token
+                break;
+            
+            i++;
+        }
+        else
+        {
+            for( ; i < length && (line[i] == '\r' || line[i] == '\n' || ! isspace((unsigned char)line[i])); i++)
+                if(line[i] != '\r' && line[i] != '\n')
+                    token += line[i];
+        }
+        
         tokens.push_back(token);
+    }
     
     return tokens;
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class LineReader
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Hands out the lines of a file already read into memory as views into that text, no per-line copy or regex clean up.
+    // The text is not copied, so it has to outlive the reader.
+private:
+    string_view buffer_;
+    size_t position_ = 0;
+    
+public:
+    LineReader(const string &buffer) : buffer_(buffer) {}
+    LineReader(string &&buffer) = delete;
+    
+    bool GetLine(string_view &line)
+    {
+        if(position_ >= buffer_.size())
+            return false;
+        
+        size_t end = buffer_.find('\n', position_);
+        
+        if(end == string::npos)
+            end = buffer_.size();
+        
+        line = buffer_.substr(position_, end - position_);
+        position_ = end + 1;
+        
+        return true;
+    }
+    
+    // Zone files -- strips the trailing comment and surrounding whitespace, returns an empty view for blank and comment lines
+    static string_view GetZoneLine(string_view line)
+    {
+        // Trailing comment -- CR/LF are ignored everywhere, so "/\r/" still counts as "//"
+        for(size_t i = 0; i < line.size(); i++)
+        {
+            if(line[i] != '/')
+                continue;
+            
+            size_t j = i + 1;
+            
+            while(j < line.size() && (line[j] == '\r' || line[j] == '\n'))
+                j++;
+            
+            if(j < line.size() && line[j] == '/')
+            {
+                line = line.substr(0, i);
+                break;
+            }
+        }
+        
+        while(line.size() > 0 && isspace((unsigned char)line.front()))
+            line.remove_prefix(1);
+        
+        while(line.size() > 0 && isspace((unsigned char)line.back()))
+            line.remove_suffix(1);
+        
+        if(line.size() > 0 && line[0] == '/')
+            return string_view();
+        
+        return line;
+    }
+    
+    // Surface and ini files -- blank once CR/LF are ignored, or starting with '/'
+    static bool GetIsBlankOrComment(string_view line)
+    {
+        for(char c : line)
+        {
+            if(c == '\r' || c == '\n')
+                continue;
+            
+            return c == '/';
+        }
+        
+        return true;
+    }
+};
+
 struct CSIWidgetInfo
 {
     std::string group = "General";
@@ -113,6 +268,80 @@ struct CSIWidgetInfo
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class DisplayString
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Last text sent to a display -- held inline so the per tick change check is a length compare plus memcmp, no heap
+public:
+    static const int Capacity = 56; // the longest display in use, a full MCU scribble strip row
+    
+private:
+    char text_[Capacity + 1];
+    size_t length_ = 0;
+    string overflow_ = ""; // only for the odd longer value, e.g. a long OSC string
+    
+    bool Equals(const char* value, size_t length) const
+    {
+        if(length != length_)
+            return false;
+        
+        return memcmp(length_ <= Capacity ? text_ : overflow_.data(), value, length) == 0;
+    }
+    
+    void Assign(const char* value, size_t length)
+    {
+        length_ = length;
+        
+        if(length <= Capacity)
+        {
+            memcpy(text_, value, length);
+            text_[length] = 0;
+            overflow_.clear();
+        }
+        else
+        {
+            text_[0] = 0;
+            overflow_.assign(value, length);
+        }
+    }
+    
+public:
+    DisplayString() { text_[0] = 0; }
+    DisplayString(const char* value) { Assign(value, strlen(value)); }
+    
+    DisplayString &operator=(const string &value) { Assign(value.data(), value.size()); return *this; }
+    DisplayString &operator=(const char* value) { Assign(value, strlen(value)); return *this; }
+    
+    bool operator==(const string &value) const { return Equals(value.data(), value.size()); }
+    bool operator!=(const string &value) const { return ! Equals(value.data(), value.size()); }
+    friend bool operator!=(const string &value, const DisplayString &displayString) { return displayString != value; }
+    
+    const char* c_str() const { return length_ <= Capacity ? text_ : overflow_.c_str(); }
+    size_t size() const { return length_; }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TrackColor
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // A track's colour in the form each device family sends it, worked out once per track rather than once per widget
+    rgb_color rgb;
+    rgb_color rgb7Bit; // Launchpad and FaderPort only take 7 bit components
+    int mftColorIndex = -1; // MFT palette entry, looked up by the first MFT encoder to show this colour
+    
+    TrackColor() {}
+    
+    TrackColor(rgb_color color) : rgb(color)
+    {
+        rgb7Bit.r = color.r / 2;
+        rgb7Bit.g = color.g / 2;
+        rgb7Bit.b = color.b / 2;
+    }
+    
+    bool GetIsSameColor(rgb_color color) const { return color.r == rgb.r && color.g == rgb.g && color.b == rgb.b; }
+};
+
 class CSurfIntegrator;
 class Page;
 class ControlSurface;
@@ -124,6 +353,7 @@ class TrackNavigationManager;
 class FeedbackProcessor;
 class Zone;
 class ActionContext;
+struct ParsedZone;
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -264,6 +494,135 @@ public:
     virtual MediaTrack* GetTrack() override;
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct ActionContextValues
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // The parts of an ActionContext that come straight from its zone file line and never change.
+    // Built once per template line and shared by every channel the line expands to.
+    vector<double> steppedValues;
+    
+    // steppedValues keeps the zone file order (it drives cycling), these are the sorted lookup tables for feedback
+    vector<double> steppedValueBinBoundaries;
+    vector<int> steppedValueSortedIndices;
+    
+    double deltaValue = 0.0;
+    vector<double> acceleratedDeltaValues;
+    vector<int> acceleratedTickValues;
+    
+    bool hasRange = false;
+    double rangeMinimum = 0.0;
+    double rangeMaximum = 1.0;
+    
+    bool supportsRGB = false;
+    vector<rgb_color> RGBValues;
+    bool supportsTrackColor = false;
+    
+    bool noFeedback = false;
+    
+    bool isSoftTakeover = false;
+    double softTakeoverWindow = SoftTakeoverWindow;
+    
+    vector<vector<string>> properties;
+    
+    static shared_ptr<const ActionContextValues> Build(const vector<string> &params, const vector<vector<string>> &properties);
+    
+    static const int MaxScannedSteps = 4; // below this many steps a plain scan beats the bin search
+    
+    int GetSteppedValueIndex(double value) const // the step closest to value, only call when there are steppedValues
+    {
+        if((int)steppedValues.size() < MaxScannedSteps)
+        {
+            // First closest step in zone file order, the same answer the bins give
+            int index = 0;
+            
+            for(int i = 1; i < (int)steppedValues.size(); i++)
+                if(fabs(steppedValues[i] - value) < fabs(steppedValues[index] - value))
+                    index = i;
+            
+            return index;
+        }
+        
+        // The bin boundaries are the midpoints between neighbouring sorted values, so the closest step is in the bin found or next to it.
+        // Those are compared the way the old linear scan did -- nearest wins, a tie goes to the step listed first in the zone file,
+        // whichever way the steps run.
+        int position = int(lower_bound(steppedValueBinBoundaries.begin(), steppedValueBinBoundaries.end(), value) - steppedValueBinBoundaries.begin());
+        
+        int index = steppedValueSortedIndices[position];
+        double delta = fabs(steppedValues[index] - value);
+        
+        for(int neighbour = position - 1; neighbour <= position + 1; neighbour += 2)
+        {
+            if(neighbour < 0 || neighbour >= (int)steppedValueSortedIndices.size())
+                continue;
+            
+            int neighbourIndex = steppedValueSortedIndices[neighbour];
+            double neighbourDelta = fabs(steppedValues[neighbourIndex] - value);
+            
+            if(neighbourDelta < delta || (neighbourDelta == delta && neighbourIndex < index))
+            {
+                index = neighbourIndex;
+                delta = neighbourDelta;
+            }
+        }
+        
+        return index;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class SoftTakeover
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Absolute input is ignored until it catches the parameter, then follows it until something else moves the parameter.
+    // The parameter is passed in on every message, so a bank change or automation is seen straight away.
+private:
+    bool isCaught_ = false;
+    bool hasInput_ = false;
+    double lastInput_ = 0.0;
+    double lastValue_ = 0.0;
+    double offset_ = 0.0;
+    
+public:
+    bool GetIsCaught() { return isCaught_; }
+    double GetOffset() { return offset_; } // input minus parameter while waiting to catch, 0 once caught
+    
+    void Reset()
+    {
+        isCaught_ = false;
+        hasInput_ = false;
+        offset_ = 0.0;
+    }
+    
+    // true if value should be applied to the parameter
+    bool SetInput(double value, double parameter, double window)
+    {
+        // Automation, the mouse or a bank change moved the parameter away from where we left it
+        if(isCaught_ && fabs(parameter - lastValue_) > window)
+        {
+            isCaught_ = false;
+            hasInput_ = false;
+        }
+        
+        if( ! isCaught_)
+        {
+            // Inside the window, or crossed the parameter since the last message -- a fast move can't jump past it
+            if(fabs(value - parameter) < window || (hasInput_ && (lastInput_ - parameter) * (value - parameter) <= 0.0))
+                isCaught_ = true;
+            
+            hasInput_ = true;
+            lastInput_ = value;
+        }
+        
+        if(isCaught_)
+            lastValue_ = value;
+        
+        offset_ = isCaught_ ? 0.0 : value - parameter;
+        
+        return isCaught_;
+    }
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class ActionContext
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -290,38 +649,148 @@ private:
     double rangeMinimum_ = 0.0;
     double rangeMaximum_ = 1.0;
     
-    vector<double> steppedValues_;
+    shared_ptr<const ActionContextValues> values_;
+    
     int steppedValuesIndex_ = 0;
     
-    double deltaValue_ = 0.0;
-    vector<double> acceleratedDeltaValues_;
-    vector<int> acceleratedTickValues_;
     int accumulatedIncTicks_ = 0;
     int accumulatedDecTicks_ = 0;
     
     bool isFeedbackInverted_ = false;
     double holdDelayAmount_ = 0.0;
-    double delayStartTime_ = 0.0;
     double deferredValue_ = 0.0;
+    double timerDeadline_ = 0.0; // 0 == no timer pending with the surface
+    
+    bool isLongPress_ = false;
+    bool hasLongPressFired_ = false;
+    bool isDoubleTap_ = false;
+    
+    void StartTimer(double delay);
+    void CancelTimer();
     
     bool shouldUseDisplayStyle_ = false;
     int displayStyle_ = 0;
     
+    SoftTakeover softTakeover_;
+    MediaTrack* softTakeoverTrack_ = nullptr; // the track softTakeover_ caught on, a different one starts over
+    
+    bool hasForwardedValue_ = false;
+    double lastForwardedValue_ = 0.0; // what UpdateWidgetValue(double) last passed on, only trusted while the widget says this binding sent it
+    
+    bool GetIsSoftTakeoverCaught(double value);
+    
     bool supportsRGB_ = false;
     vector<rgb_color> RGBValues_;
     int currentRGBIndex_ = 0;
     
     bool supportsTrackColor_ = false;
     
-    vector<string> autoModeDisplayNames__ = { "Trim", "Read", "Touch", "Write", "Latch", "LtchPre" };
+    static inline const vector<string> autoModeDisplayNames__ = { "Trim", "Read", "Touch", "Write", "Latch", "LtchPre" };
     int autoModeIndex_ = 0;
     
-    bool noFeedback_ = false;
+    // Last raw value this binding formatted and the text it produced -- the text is only rebuilt when the raw value moves
+    FormattedValueType formattedValueType_ = NoFormattedValue;
+    double formattedRawValue_ = 0.0;
+    string formattedValue_ = "";
+    
+    static int GetPercentValue(double value)
+    {
+        return value < 0 ? -int(-value * 100.0) : int(value * 100.0);
+    }
+    
+    static string FormatPanValue(int panIntVal)
+    {
+        bool left = false;
+        
+        if(panIntVal < 0)
+        {
+            left = true;
+            panIntVal = -panIntVal;
+        }
+        
+        string trackPanValueString = "";
+        
+        if(left)
+        {
+            if(panIntVal == 100)
+                trackPanValueString += "<";
+            else if(panIntVal < 100 && panIntVal > 9)
+                trackPanValueString += "< ";
+            else
+                trackPanValueString += "<  ";
+            
+            trackPanValueString += to_string(panIntVal);
+        }
+        else
+        {
+            trackPanValueString += "   ";
+            
+            trackPanValueString += to_string(panIntVal);
+            
+            if(panIntVal == 100)
+                trackPanValueString += ">";
+            else if(panIntVal < 100 && panIntVal > 9)
+                trackPanValueString += " >";
+            else
+                trackPanValueString += "  >";
+        }
+        
+        if(panIntVal == 0)
+            trackPanValueString = "  <C>  ";
+
+        return trackPanValueString;
+    }
+    
+    static string FormatPanWidthValue(int widthIntVal)
+    {
+        bool reversed = false;
+        
+        if(widthIntVal < 0)
+        {
+            reversed = true;
+            widthIntVal = -widthIntVal;
+        }
+        
+        string trackPanWidthString = "";
+        
+        if(reversed)
+            trackPanWidthString += "Rev ";
+        
+        trackPanWidthString += to_string(widthIntVal);
+        
+        if(widthIntVal == 0)
+            trackPanWidthString = " <Mno> ";
+
+        return trackPanWidthString;
+    }
+    
+    // Pan and width display in whole percent, so -100 .. 100 covers every string either can show
+    static vector<string> BuildPercentStrings(string (*format)(int))
+    {
+        vector<string> strings;
+        
+        for(int percent = -100; percent <= 100; percent++)
+            strings.push_back(format(percent));
+        
+        return strings;
+    }
+    
+    static inline const vector<string> panValueStrings__ = BuildPercentStrings(FormatPanValue);
+    static inline const vector<string> panWidthValueStrings__ = BuildPercentStrings(FormatPanWidthValue);
     
-    vector<vector<string>> properties_;
+    bool GetIsFormattedValueCurrent(FormattedValueType type, double rawValue)
+    {
+        if(formattedValueType_ == type && formattedRawValue_ == rawValue)
+            return true;
+        
+        formattedValueType_ = type;
+        formattedRawValue_ = rawValue;
+        
+        return false;
+    }
     
 public:
-    ActionContext(Action* action, Widget* widget, Zone* zone, vector<string> params, vector<vector<string>> properties);
+    ActionContext(Action* action, Widget* widget, Zone* zone, const vector<string> &params, shared_ptr<const ActionContextValues> values);
     virtual ~ActionContext() {}
     
     Widget* GetWidget() { return widget_; }
@@ -351,20 +820,25 @@ public:
     int GetParamIndex() { return paramIndex_; }
     
     bool GetSupportsRGB() { return supportsRGB_; }
+    double GetSoftTakeoverOffset() { return softTakeover_.GetOffset(); }
     
     void SetIsFeedbackInverted() { isFeedbackInverted_ = true; }
     void SetHoldDelayAmount(double holdDelayAmount) { holdDelayAmount_ = holdDelayAmount * 1000.0; } // holdDelayAmount is specified in seconds, holdDelayAmount_ is in milliseconds
+    void SetIsLongPress() { isLongPress_ = true; }
+    void SetIsDoubleTap() { isDoubleTap_ = true; }
     
     void DoAction(double value);
     void DoRelativeAction(double value);
     void DoRelativeAction(int accelerationIndex, double value);
     
     void RequestUpdate();
-    void RunDeferredActions();
+    void RunDeferredAction();
+    void DropDeferredAction();
     void ClearWidget();
     void UpdateWidgetValue(double value);
     void UpdateWidgetValue(int param, double value);
-    void UpdateWidgetValue(string value);
+    void UpdateWidgetValue(const string &value);
+    void UpdateWidgetValue(const string &value, int generation);
     void ForceWidgetValue(double value);
 
     void SetAutoModeIndex()
@@ -404,19 +878,7 @@ public:
         action_->Touch(this, value);
     }
     
-    string GetFxParamDisplayName()
-    {
-        if(fxParamDisplayName_ != "")
-            return fxParamDisplayName_;
-        else if(MediaTrack* track = GetTrack())
-        {
-            char fxParamName[BUFSZ];
-            DAW::TrackFX_GetParamName(track, GetSlotIndex(), paramIndex_, fxParamName, sizeof(fxParamName));
-            return fxParamName;
-        }
-        
-        return "";
-    }
+    string GetFxParamDisplayName();
 
     void SetCurrentRGB(rgb_color newColor)
     {
@@ -435,86 +897,47 @@ public:
     
     void SetSteppedValueIndex(double value)
     {
-        int index = 0;
-        double delta = 100000000.0;
-        
-        for(int i = 0; i < steppedValues_.size(); i++)
-            if(abs(steppedValues_[i] - value) < delta)
-            {
-                delta = abs(steppedValues_[i] - value);
-                index = i;
-            }
-        
-        steppedValuesIndex_ = index;
+        if(values_->steppedValues.size() > 0)
+            steppedValuesIndex_ = values_->GetSteppedValueIndex(value);
     }
 
     string GetPanValueString(double panVal)
     {
-        bool left = false;
-        
-        if(panVal < 0)
-        {
-            left = true;
-            panVal = -panVal;
-        }
+        int panIntVal = GetPercentValue(panVal);
         
-        int panIntVal = int(panVal * 100.0);
-        string trackPanValueString = "";
-        
-        if(left)
-        {
-            if(panIntVal == 100)
-                trackPanValueString += "<";
-            else if(panIntVal < 100 && panIntVal > 9)
-                trackPanValueString += "< ";
-            else
-                trackPanValueString += "<  ";
-            
-            trackPanValueString += to_string(panIntVal);
-        }
+        if(panIntVal >= -100 && panIntVal <= 100)
+            return panValueStrings__[panIntVal + 100];
         else
-        {
-            trackPanValueString += "   ";
-            
-            trackPanValueString += to_string(panIntVal);
-            
-            if(panIntVal == 100)
-                trackPanValueString += ">";
-            else if(panIntVal < 100 && panIntVal > 9)
-                trackPanValueString += " >";
-            else
-                trackPanValueString += "  >";
-        }
-        
-        if(panIntVal == 0)
-            trackPanValueString = "  <C>  ";
-
-        return trackPanValueString;
+            return FormatPanValue(panIntVal);
     }
     
     string GetPanWidthValueString(double widthVal)
     {
-        bool reversed = false;
-        
-        if(widthVal < 0)
-        {
-            reversed = true;
-            widthVal = -widthVal;
-        }
-        
-        int widthIntVal = int(widthVal * 100.0);
-        string trackPanWidthString = "";
+        int widthIntVal = GetPercentValue(widthVal);
         
-        if(reversed)
-            trackPanWidthString += "Rev ";
+        if(widthIntVal >= -100 && widthIntVal <= 100)
+            return panWidthValueStrings__[widthIntVal + 100];
+        else
+            return FormatPanWidthValue(widthIntVal);
+    }
+    
+    const string &GetFormattedPanValue(double panVal)
+    {
+        if( ! GetIsFormattedValueCurrent(PanFormattedValue, panVal))
+            formattedValue_ = GetPanValueString(panVal);
         
-        trackPanWidthString += to_string(widthIntVal);
+        return formattedValue_;
+    }
+    
+    const string &GetFormattedPanWidthValue(double widthVal)
+    {
+        if( ! GetIsFormattedValueCurrent(PanWidthFormattedValue, widthVal))
+            formattedValue_ = GetPanWidthValueString(widthVal);
         
-        if(widthIntVal == 0)
-            trackPanWidthString = " <Mno> ";
-
-        return trackPanWidthString;
+        return formattedValue_;
     }
+    
+    const string &GetFormattedVolumeValue(double vol);
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -525,14 +948,15 @@ private:
     ControlSurface* const surface_ = nullptr;
     Navigator* navigator_= nullptr;
     string const name_ = "";
-    string const alias_ = "";
+    string alias_ = "";
     string const sourceFilePath_ = "";
     
     map<string, string> touchIds_;
         
     map<string, bool> activeTouchIds_;
+    map<string, Widget*> pressWidgets_; // "<Widget>Press" touch ids resolved to their widgets, whose pressed state lives on the widget
     
-    NavigationStyle const navigationStyle_ = Standard;
+    NavigationStyle navigationStyle_ = Standard;
     
     int slotIndex_ = 0;
 
@@ -545,9 +969,16 @@ private:
     vector<ActionContext> defaultContexts_;
     
 public:   
-    Zone(ControlSurface* surface, Navigator* navigator, NavigationStyle navigationStyle, int slotIndex, map<string, string> touchIds, string name, string alias, string sourceFilePath): surface_(surface), navigator_(navigator), navigationStyle_(navigationStyle), slotIndex_(slotIndex), touchIds_(touchIds), name_(name), alias_(alias), sourceFilePath_(sourceFilePath) {}
+    Zone(ControlSurface* surface, Navigator* navigator, NavigationStyle navigationStyle, int slotIndex, map<string, string> touchIds, string name, string alias, string sourceFilePath): surface_(surface), navigator_(navigator), navigationStyle_(navigationStyle), slotIndex_(slotIndex), touchIds_(touchIds), name_(name), alias_(alias), sourceFilePath_(sourceFilePath)
+    {
+        ResolvePressWidgets();
+    }
+    
     Zone() {}
     
+    void ResolvePressWidgets();
+    
+    void Reload(Navigator* navigator, NavigationStyle navigationStyle, int slotIndex, map<string, string> touchIds, string alias);
     void Activate();
     void Activate(vector<Zone*> *activeZones);
     void Deactivate();
@@ -558,6 +989,7 @@ public:
     Navigator* GetNavigator() { return navigator_; }
     void SetNavigator(Navigator* navigator) { navigator_ = navigator; }
     void AddIncludedZone(Zone* &zone) { includedZones_.push_back(zone); }
+    void HandleWidgetInput(Widget* widget);
     void RequestUpdateWidget(Widget* widget);
 
     void SetSlotIndex(int index)
@@ -579,6 +1011,9 @@ public:
         return name_;
     }
     
+    string GetSourceFilePath() { return sourceFilePath_; }
+    vector<Widget*> &GetWidgets() { return widgets_; }
+    
     string GetNameOrAlias()
     {
         if(alias_ != "")
@@ -597,27 +1032,22 @@ public:
         actionContextDictionary_[widget][modifier].push_back(actionContext);
     }
     
-    void RequestUpdate(vector<Widget*> &usedWidgets)
+    void GetWidgetsForUpdate(vector<Widget*> &usedWidgets, vector<Zone*> &owningZones)
     {
         for(auto widget : widgets_)
         {
             if(find(usedWidgets.begin(), usedWidgets.end(), widget) == usedWidgets.end())
             {
                 usedWidgets.push_back(widget);
-
-                RequestUpdateWidget(widget);
+                owningZones.push_back(this);
             }
         }
         
         for(auto zone : includedZones_)
-            zone->RequestUpdate(usedWidgets);
+            zone->GetWidgetsForUpdate(usedWidgets, owningZones);
     }
         
-    void DoAction(Widget* widget, double value)
-    {
-        for(auto &context : GetActionContexts(widget))
-            context.DoAction(value);
-    }
+    void DoAction(Widget* widget, double value);
     
     void DoTouch(Widget* widget, string widgetName, double value)
     {
@@ -661,6 +1091,14 @@ private:
     
     bool isModifier_ = false;
     bool isToggled_ = false;
+    bool isPressed_ = false; // last input value was non zero, read by every zone with a "<Widget>Press+" binding
+    
+    int lastStringGeneration_ = 0; // generation of the cached string the processors were last given, 0 if it came from anywhere else
+    
+    ActionContext* valueMemoOwner_ = nullptr; // the binding whose UpdateWidgetValue(double) the processors last saw, anything else sent here clears it
+    double feedbackEpsilon_ = 0.0; // the finest resolution any of the processors can show
+    
+    bool isCleared_ = false; // processors were last told to Clear and nothing has been sent since, so clearing again would change nothing
     
     vector<double> queuedActionValues_;
     vector<double> queuedRelativeActionValues_;
@@ -680,15 +1118,22 @@ public:
     
     void Toggle() { isToggled_ = ! isToggled_; }
     bool GetIsToggled() { return isToggled_; }
+    
+    bool GetIsPressed() { return isPressed_; }
 
     void SetProperties(vector<vector<string>> properties);
     void UpdateValue(double value);
     void UpdateValue(int mode, double value);
-    void UpdateValue(string value);
+    void UpdateValue(const string &value);
+    void UpdateValue(const string &value, int generation);
     void UpdateRGBValue(int r, int g, int b);
+    void UpdateTrackColor(TrackColor &color);
+    void UpdateSoftTakeoverOffset(double offset);
     void ForceValue(double value);
     void ForceRGBValue(int r, int g, int b);
+    void ForceTrackColor(TrackColor &color);
     void ClearCache();
+    void CopyCacheFrom(Widget* source);
     void Clear();
     void ForceClear();
 
@@ -728,6 +1173,8 @@ public:
     {
         LogInput(value);
         
+        isPressed_ = value != 0.0; // set on arrival so a press lets "WidgetPress+Encoder" bindings in any zone see it, bound or not
+        
         queuedActionValues_.push_back(value);
     }
     
@@ -752,10 +1199,11 @@ public:
         queuedTouchActionValues_.push_back(value);
     }
 
-    void AddFeedbackProcessor(FeedbackProcessor* feedbackProcessor)
-    {
-        feedbackProcessors_.push_back(feedbackProcessor);
-    }
+    void AddFeedbackProcessor(FeedbackProcessor* feedbackProcessor);
+    
+    double GetFeedbackEpsilon() { return feedbackEpsilon_; }
+    bool GetIsValueMemoOwner(ActionContext* context) { return context == valueMemoOwner_; }
+    void SetValueMemoOwner(ActionContext* context) { valueMemoOwner_ = context; }
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -808,7 +1256,7 @@ class FeedbackProcessor
 {
 protected:
     double lastDoubleValue_ = 0.0;
-    string lastStringValue_ = "";
+    DisplayString lastStringValue_;
    
     Widget* const widget_ = nullptr;
     
@@ -821,12 +1269,18 @@ public:
     virtual void ForceValue(double value) {}
     virtual void ForceValue(int param, double value) {}
     virtual void ForceRGBValue(int r, int g, int b) {}
-    virtual void ForceValue(string value) {}
+    virtual void SetTrackColor(TrackColor &color) { SetRGBValue(color.rgb.r, color.rgb.g, color.rgb.b); } // devices with their own colour format take it from color
+    virtual void ForceTrackColor(TrackColor &color) { ForceRGBValue(color.rgb.r, color.rgb.g, color.rgb.b); }
+    virtual void ForceValue(const string &value) {}
     virtual void SetColors(rgb_color textColor, rgb_color textBackground) {}
     virtual void SetCurrentColor(double value) {}
     virtual void SetProperties(vector<vector<string>> properties) {}
+    virtual void SetSoftTakeoverOffset(double offset) {} // input minus parameter while a soft takeover is waiting to catch, 0 once caught
+    virtual void RunDeferredFeedback() {} // called every tick, sends anything the processor held back
 
     virtual int GetMaxCharacters() { return 0; }
+    virtual double GetFeedbackEpsilon() { return 0.0; } // normalised changes smaller than this can't show, 0 means every change can
+    virtual int GetSupportedValueChannels() { return AllValueChannels; } // FeedbackValueChannel flags, Clear only sends to these
     
     virtual void SetValue(double value)
     {
@@ -840,7 +1294,7 @@ public:
             ForceValue(value);
     }
     
-    virtual void SetValue(string value)
+    virtual void SetValue(const string &value)
     {
         if(lastStringValue_ != value)
             ForceValue(value);
@@ -852,20 +1306,38 @@ public:
         lastStringValue_ = "";
     }
     
+    virtual void CopyCacheFrom(FeedbackProcessor* source)
+    {
+        lastDoubleValue_ = source->lastDoubleValue_;
+        lastStringValue_ = source->lastStringValue_;
+    }
+    
     virtual void Clear()
     {
-        SetValue(0.0);
-        SetValue(0, 0.0);
-        SetValue("");
-        SetRGBValue(0, 0, 0);
+        int channels = GetSupportedValueChannels();
+        
+        if(channels & DoubleValueChannel)
+            SetValue(0.0);
+        if(channels & ParamValueChannel)
+            SetValue(0, 0.0);
+        if(channels & StringValueChannel)
+            SetValue("");
+        if(channels & RGBValueChannel)
+            SetRGBValue(0, 0, 0);
     }
     
     virtual void ForceClear()
     {
-        ForceValue(0.0);
-        ForceValue(0, 0.0);
-        ForceValue("");
-        ForceRGBValue(0, 0, 0);
+        int channels = GetSupportedValueChannels();
+        
+        if(channels & DoubleValueChannel)
+            ForceValue(0.0);
+        if(channels & ParamValueChannel)
+            ForceValue(0, 0.0);
+        if(channels & StringValueChannel)
+            ForceValue("");
+        if(channels & RGBValueChannel)
+            ForceRGBValue(0, 0, 0);
     }
 };
 
@@ -895,6 +1367,8 @@ public:
         lastMessageSent_->midi_message[1] = 0;
         lastMessageSent_->midi_message[2] = 0;
     }
+    
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -912,7 +1386,7 @@ public:
 
     virtual void ForceValue(double value) override;
     virtual void ForceValue(int param, double value) override;
-    virtual void ForceValue(string value) override;
+    virtual void ForceValue(const string &value) override;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -930,7 +1404,7 @@ public:
 
     virtual void ForceValue(double value) override;
     virtual void ForceValue(int param, double value) override;
-    virtual void ForceValue(string value) override;
+    virtual void ForceValue(const string &value) override;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1025,10 +1499,30 @@ protected:
     map<string, Zone*> zonesByName_;
     vector<Zone*> zones_;
     
+    int numMessagesSent_ = 0;
+    
+    // Budgeted update -- feedback resumes at updateCursor_ on the next tick when the budget runs out
+    vector<Widget*> usedWidgets_;
+    vector<Zone*> usedWidgetZones_;
+    
+    // Pending Hold, LongPress and DoubleTap timers, ordered by deadline so a tick only looks at the expired ones
+    multimap<double, ActionContext*> deferredActions_;
+    void RunDeferredActions();
+    
+    // Processors that can hold feedback back, e.g. rate limited motor faders -- they get a look in every tick
+    vector<FeedbackProcessor*> deferredFeedbackProcessors_;
+    int updateCursor_ = 0;
+    int updatePassProgress_ = 0;
+    int ticksInCurrentUpdatePass_ = 0;
+    int maxTicksPerUpdatePass_ = 0;
+    int updateOverrunCount_ = 0;
+    int updateTickCount_ = 0;
+    
     void MapSelectedTrackFXSlotToWidgets(vector<Zone*> *activeZones, int fxSlot);
     void MapSelectedTrackItemsToWidgets(MediaTrack* track, string baseName, int numberOfZones, vector<Zone*> *activeZones);
     
     void GoZone(vector<Zone*> *activeZones, string zoneName, double value);
+    void GetActiveWidgets(vector<Widget*> &widgets, vector<Zone*> &owningZones);
     
     virtual void InitHardwiredWidgets()
     {
@@ -1107,6 +1601,9 @@ public:
     
     void LoadZone(string zoneName);
     Zone* GetZone(string zoneName);
+    Zone* GetZoneFromFile(string zoneName, string filePath);
+    void ReplaceZone(Zone* zone, Zone* replacement);
+    void ReloadZoneFile(string filePath, shared_ptr<const ParsedZone> parsedZone);
     void GoZone(string zoneName, double value);
     void GoSubZone(Zone* enclosingZone, string zoneName, double value);
     virtual void LoadingZone(string zoneName) {}
@@ -1200,43 +1697,65 @@ public:
         zoneFilenames_[name] = filename;
     }
     
+    string GetZoneFilename(string zoneName)
+    {
+        if(zoneFilenames_.count(zoneName) > 0)
+            return zoneFilenames_[zoneName];
+        else
+            return "";
+    }
+    
     void AddZone(Zone* zone)
     {
         zonesByName_[zone->GetName()] = zone;
         zones_.push_back(zone);
     }
    
-    void CheckFocusedFXState()
+    void CheckFocusedFXState();
+    
+    virtual void RequestUpdate(double updateDeadline);
+    void ReportUpdateStatistics();
+    void CopyCacheFrom(ControlSurface* source);
+    
+    void AddDeferredFeedbackProcessor(FeedbackProcessor* feedbackProcessor)
     {
-        int trackNumber = 0;
-        int itemNumber = 0;
-        int fxIndex = 0;
-        
-        if(DAW::GetFocusedFX2(&trackNumber, &itemNumber, &fxIndex) & 0x04) // 4 set if FX is no longer focused but still open
-            UnmapFocusedFXFromWidgets();
+        deferredFeedbackProcessors_.push_back(feedbackProcessor);
     }
     
-    virtual void RequestUpdate()
+    void ScheduleDeferredAction(ActionContext* context, double deadline)
     {
-        CheckFocusedFXState();
-        
-        vector<Widget*> usedWidgets;
-
-        for(auto activeZones : allActiveZones_)
-            for(auto zone : *activeZones)
-                zone->RequestUpdate(usedWidgets);
-        
-        if(homeZone_ != nullptr)
-            homeZone_->RequestUpdate(usedWidgets);
+        deferredActions_.insert(make_pair(deadline, context));
+    }
+    
+    void CancelDeferredAction(ActionContext* context, double deadline)
+    {
+        auto range = deferredActions_.equal_range(deadline);
         
-        for(auto widget : widgets_)
+        for(auto it = range.first; it != range.second; ++it)
         {
-            auto it = find(usedWidgets.begin(), usedWidgets.end(), widget);
-            
-            if ( it == widgets_.end() )
-                widget->Clear();
+            if(it->second == context)
+            {
+                deferredActions_.erase(it);
+                break;
+            }
+        }
+    }
+    
+    void CancelDeferredActions(Zone* zone)
+    {
+        for(auto it = deferredActions_.begin(); it != deferredActions_.end(); )
+        {
+            if(it->second->GetZone() == zone)
+            {
+                it->second->DropDeferredAction();
+                it = deferredActions_.erase(it);
+            }
+            else
+                ++it;
         }
     }
+    
+    int GetNumMessagesSent() { return numMessagesSent_; }
 
     virtual void ForceClearAllWidgets()
     {
@@ -1550,6 +2069,47 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TrackRouting
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    int numHardwareSends = 0;
+    int numSends = 0;
+    int numReceives = 0;
+    vector<MediaTrack*> sendDestinations;
+    vector<string> sendDestinationNames;
+    vector<MediaTrack*> receiveSources;
+    vector<string> receiveSourceNames;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TrackNameEntry
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    string name = "";
+    int generation = 0;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FXParamCacheEntry
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    bool hasValue = false;
+    double value = 0.0;
+    string formattedValue = "";
+    bool hasName = false;
+    string name = "";
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct FXQueryCount
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    MediaTrack* track = nullptr; // where the FX was last seen, its name is looked up from there when the counts are reported
+    int numValueQueries = 0;
+    int numNameQueries = 0;
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class TrackNavigationManager
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1580,6 +2140,169 @@ private:
     int maxReceiveSlot_ = 0;
     int maxFXMenuSlot_ = 0;
     
+    // Send/receive topology, built on first use per track, dropped when routing changes. Every RoutingVerifyInterval the cached
+    // entries are checked against REAPER and only the ones that no longer match are dropped, to be rebuilt when next asked for
+    map<MediaTrack*, TrackRouting> trackRoutings_;
+    int lastNumTracks_ = 0;
+    double lastRoutingVerifyTime_ = 0.0;
+    
+    // Colours of the tracks something has asked about. A colour change is an undoable edit, so the cache is dropped when
+    // the project state change count moves or the track list changes. Every RoutingVerifyInterval the cached colours are
+    // also read back from REAPER, to catch a colour set by a script or extension without an undo point.
+    map<MediaTrack*, TrackColor> trackColors_;
+    int lastProjectStateChangeCount_ = 0;
+    
+    // FX param text, keyed on FX GUID and param index so reordered FX can't show another plugin's strings.
+    // Formatted values are re-read when the param moves, names when the track's FX list changes.
+    map<MediaTrack*, map<string, FXParamCacheEntry>> fxParamCache_;
+    map<string, FXQueryCount> fxQueryCounts_; // FX GUID -> how often we had to ask the plugin
+    
+    FXParamCacheEntry* GetFXParamCacheEntry(MediaTrack* track, int fxIndex, int paramIndex)
+    {
+        GUID* guid = DAW::TrackFX_GetFXGUID(track, fxIndex);
+        
+        if(guid == nullptr)
+            return nullptr;
+        
+        string key(sizeof(GUID) + sizeof(int), '\0');
+        memcpy(&key[0], guid, sizeof(GUID));
+        memcpy(&key[sizeof(GUID)], &paramIndex, sizeof(int));
+        
+        return &fxParamCache_[track][key];
+    }
+    
+    FXQueryCount &GetFXQueryCount(MediaTrack* track, int fxIndex)
+    {
+        // Keyed on the GUID, asking the plugin for its name here would cost a query on every miss we are counting
+        GUID* guid = DAW::TrackFX_GetFXGUID(track, fxIndex);
+        
+        FXQueryCount &count = fxQueryCounts_[guid != nullptr ? string((const char*)guid, sizeof(GUID)) : string()];
+        count.track = track;
+        
+        return count;
+    }
+    
+    static string GetFXNameForGUID(MediaTrack* track, const string &guidKey)
+    {
+        if(guidKey.size() != sizeof(GUID) || ! DAW::ValidateTrackPtr(track))
+            return "(removed FX)";
+        
+        for(int i = 0; i < DAW::TrackFX_GetCount(track); i++)
+        {
+            GUID* guid = DAW::TrackFX_GetFXGUID(track, i);
+            
+            if(guid != nullptr && memcmp(guid, guidKey.data(), sizeof(GUID)) == 0)
+            {
+                char fxName[BUFSZ];
+                DAW::TrackFX_GetFXName(track, i, fxName, sizeof(fxName));
+                
+                return fxName;
+            }
+        }
+        
+        return "(removed FX)";
+    }
+    
+    static rgb_color ReadTrackColor(MediaTrack* track)
+    {
+        rgb_color color;
+        
+        if(unsigned int* rgb_colour = (unsigned int*)DAW::GetSetMediaTrackInfo(track, "I_CUSTOMCOLOR", NULL))
+        {
+            color.r = (*rgb_colour >> 0) & 0xff;
+            color.g = (*rgb_colour >> 8) & 0xff;
+            color.b = (*rgb_colour >> 16) & 0xff;
+        }
+        
+        return color;
+    }
+    
+    static string ReadTrackName(MediaTrack* track)
+    {
+        if(track == nullptr)
+            return "";
+        
+        if(char* name = (char *)DAW::GetSetMediaTrackInfo(track, "P_NAME", NULL))
+            return name;
+        else
+            return "";
+    }
+    
+    // Display names ("Track 3" for unnamed tracks) of the tracks something has asked about.
+    // SetTrackTitle and track list changes refresh them, RoutingVerifyInterval catches anything missed.
+    // Every change gets a new generation, so a widget that already shows it can skip the update altogether.
+    map<MediaTrack*, TrackNameEntry> trackNames_;
+    static inline int trackNameGeneration_ = 0; // shared by all pages so widgets never see the same generation for two different names
+    
+    static string ReadTrackDisplayName(MediaTrack* track)
+    {
+        char name[BUFSZ];
+        DAW::GetTrackName(track, name, sizeof(name));
+        
+        return name;
+    }
+    
+    void RefreshTrackName(TrackNameEntry &entry, MediaTrack* track)
+    {
+        SetTrackName(entry, ReadTrackDisplayName(track));
+    }
+    
+    void SetTrackName(TrackNameEntry &entry, const string &name)
+    {
+        if(entry.generation == 0 || name != entry.name)
+        {
+            entry.name = name;
+            entry.generation = ++trackNameGeneration_;
+        }
+    }
+    
+    bool GetIsTrackRoutingCurrent(MediaTrack* track, const TrackRouting &routing)
+    {
+        if( ! DAW::ValidateTrackPtr(track))
+            return false;
+        
+        if(DAW::GetTrackNumSends(track, 1) != routing.numHardwareSends || DAW::GetTrackNumSends(track, 0) != routing.numSends || DAW::GetTrackNumSends(track, -1) != routing.numReceives)
+            return false;
+        
+        for(int i = 0; i < routing.numSends; i++)
+            if((MediaTrack *)DAW::GetSetTrackSendInfo(track, 0, i + routing.numHardwareSends, "P_DESTTRACK", 0) != routing.sendDestinations[i])
+                return false;
+        
+        for(int i = 0; i < routing.numReceives; i++)
+            if((MediaTrack *)DAW::GetSetTrackSendInfo(track, -1, i, "P_SRCTRACK", 0) != routing.receiveSources[i])
+                return false;
+        
+        return true;
+    }
+    
+    TrackRouting &GetTrackRouting(MediaTrack* track)
+    {
+        if(trackRoutings_.count(track) > 0)
+            return trackRoutings_[track];
+        
+        TrackRouting &routing = trackRoutings_[track];
+        
+        routing.numHardwareSends = DAW::GetTrackNumSends(track, 1);
+        routing.numSends = DAW::GetTrackNumSends(track, 0);
+        routing.numReceives = DAW::GetTrackNumSends(track, -1);
+        
+        for(int i = 0; i < routing.numSends; i++)
+        {
+            MediaTrack* destTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, 0, i + routing.numHardwareSends, "P_DESTTRACK", 0);
+            routing.sendDestinations.push_back(destTrack);
+            routing.sendDestinationNames.push_back(ReadTrackName(destTrack));
+        }
+        
+        for(int i = 0; i < routing.numReceives; i++)
+        {
+            MediaTrack* srcTrack = (MediaTrack *)DAW::GetSetTrackSendInfo(track, -1, i, "P_SRCTRACK", 0);
+            routing.receiveSources.push_back(srcTrack);
+            routing.receiveSourceNames.push_back(ReadTrackName(srcTrack));
+        }
+        
+        return routing;
+    }
+    
 public:
     TrackNavigationManager(Page* page, bool followMCP, bool synchPages, bool scrollLink, int numChannels) : page_(page), followMCP_(followMCP), synchPages_(synchPages), scrollLink_(scrollLink),
     masterTrackNavigator_(new MasterTrackNavigator(page_)),
@@ -1726,14 +2449,181 @@ public:
     
     void OnTrackSelection()
     {
-        if(scrollLink_)
-            ForceScrollLink();
+        if(scrollLink_)
+            ForceScrollLink();
+    }
+    
+    void OnTrackListChange()
+    {
+        trackRoutings_.clear();
+        fxParamCache_.clear();
+        trackNames_.clear(); // unnamed tracks are named by position
+        trackColors_.clear();
+        
+        if(scrollLink_)
+            ForceScrollLink();
+    }
+    
+    void OnTrackNameChange(MediaTrack* track, const char* title)
+    {
+        // Send and receive names of the tracks routed to or from this one are rebuilt when next asked for
+        for(auto it = trackRoutings_.begin(); it != trackRoutings_.end(); )
+        {
+            const TrackRouting &routing = it->second;
+            
+            if(find(routing.sendDestinations.begin(), routing.sendDestinations.end(), track) != routing.sendDestinations.end()
+               || find(routing.receiveSources.begin(), routing.receiveSources.end(), track) != routing.receiveSources.end())
+                it = trackRoutings_.erase(it);
+            else
+                ++it;
+        }
+        
+        // REAPER hands us the new title, so only ask it again when there isn't one
+        if(trackNames_.count(track) > 0)
+        {
+            if(title != nullptr && title[0] != 0)
+                SetTrackName(trackNames_[track], title);
+            else
+                RefreshTrackName(trackNames_[track], track);
+        }
+    }
+    
+    const TrackNameEntry &GetTrackName(MediaTrack* track)
+    {
+        TrackNameEntry &entry = trackNames_[track];
+        
+        if(entry.generation == 0)
+            RefreshTrackName(entry, track);
+        
+        return entry;
+    }
+    
+    void OnTrackFXListChanged(MediaTrack* track)
+    {
+        fxParamCache_.erase(track);
+    }
+    
+    string GetFormattedFXParamValue(MediaTrack* track, int fxIndex, int paramIndex)
+    {
+        double value = DAW::TrackFX_GetParamNormalized(track, fxIndex, paramIndex); // normalised, so FXParamValueEpsilon means the same for every param
+        
+        FXParamCacheEntry* entry = GetFXParamCacheEntry(track, fxIndex, paramIndex);
+        
+        if(entry != nullptr && entry->hasValue && fabs(value - entry->value) <= FXParamValueEpsilon)
+            return entry->formattedValue;
+        
+        char fxParamValue[128];
+        DAW::TrackFX_GetFormattedParamValue(track, fxIndex, paramIndex, fxParamValue, sizeof(fxParamValue));
+        GetFXQueryCount(track, fxIndex).numValueQueries++;
+        
+        if(entry != nullptr)
+        {
+            entry->hasValue = true;
+            entry->value = value;
+            entry->formattedValue = fxParamValue;
+        }
+        
+        return fxParamValue;
+    }
+    
+    string GetFXParamName(MediaTrack* track, int fxIndex, int paramIndex)
+    {
+        FXParamCacheEntry* entry = GetFXParamCacheEntry(track, fxIndex, paramIndex);
+        
+        if(entry != nullptr && entry->hasName)
+            return entry->name;
+        
+        char fxParamName[128];
+        DAW::TrackFX_GetParamName(track, fxIndex, paramIndex, fxParamName, sizeof(fxParamName));
+        GetFXQueryCount(track, fxIndex).numNameQueries++;
+        
+        if(entry != nullptr)
+        {
+            entry->hasName = true;
+            entry->name = fxParamName;
+        }
+        
+        return fxParamName;
+    }
+    
+    void ReportFXQueryCounts()
+    {
+        // Instances of the same plugin are added together under its name
+        map<string, FXQueryCount> countsByName;
+        
+        for(auto &[guidKey, count] : fxQueryCounts_)
+        {
+            FXQueryCount &total = countsByName[GetFXNameForGUID(count.track, guidKey)];
+            total.numValueQueries += count.numValueQueries;
+            total.numNameQueries += count.numNameQueries;
+        }
+        
+        vector<pair<string, FXQueryCount>> counts(countsByName.begin(), countsByName.end());
+        
+        // Most formatted value queries first, those are the plugins that cost us every time a param moves
+        sort(counts.begin(), counts.end(), [](const pair<string, FXQueryCount> &a, const pair<string, FXQueryCount> &b) { return a.second.numValueQueries > b.second.numValueQueries; });
+        
+        for(auto &[fxName, count] : counts)
+        {
+            char buffer[BUFSZ + 100];
+            snprintf(buffer, sizeof(buffer), "FX queries -- %s -- %d formatted values, %d param names\n", fxName.c_str(), count.numValueQueries, count.numNameQueries);
+            DAW::ShowConsoleMsg(buffer);
+        }
+    }
+    
+    TrackColor &GetTrackColor(MediaTrack* track)
+    {
+        auto it = trackColors_.find(track);
+        
+        if(it == trackColors_.end())
+            it = trackColors_.emplace(track, TrackColor(ReadTrackColor(track))).first;
+        
+        return it->second;
+    }
+    
+    int GetNumHardwareSends(MediaTrack* track)
+    {
+        return GetTrackRouting(track).numHardwareSends;
+    }
+    
+    MediaTrack* GetSendDestination(MediaTrack* track, int sendSlot)
+    {
+        TrackRouting &routing = GetTrackRouting(track);
+        
+        if(sendSlot >= 0 && sendSlot < (int)routing.sendDestinations.size())
+            return routing.sendDestinations[sendSlot];
+        else
+            return nullptr;
+    }
+    
+    string GetSendDestinationName(MediaTrack* track, int sendSlot)
+    {
+        TrackRouting &routing = GetTrackRouting(track);
+        
+        if(sendSlot >= 0 && sendSlot < (int)routing.sendDestinationNames.size())
+            return routing.sendDestinationNames[sendSlot];
+        else
+            return "";
+    }
+    
+    MediaTrack* GetReceiveSource(MediaTrack* track, int receiveSlot)
+    {
+        TrackRouting &routing = GetTrackRouting(track);
+        
+        if(receiveSlot >= 0 && receiveSlot < (int)routing.receiveSources.size())
+            return routing.receiveSources[receiveSlot];
+        else
+            return nullptr;
     }
     
-    void OnTrackListChange()
+    string GetReceiveSourceName(MediaTrack* track, int receiveSlot)
     {
-        if(scrollLink_)
-            ForceScrollLink();
+        TrackRouting &routing = GetTrackRouting(track);
+        
+        if(receiveSlot >= 0 && receiveSlot < (int)routing.receiveSourceNames.size())
+            return routing.receiveSourceNames[receiveSlot];
+        else
+            return "";
     }
 
     void ToggleVCASpill(MediaTrack* track)
@@ -1767,6 +2657,58 @@ public:
         // Clean up vcaSpillTracks
         vcaSpillTracks_.erase(remove_if(vcaSpillTracks_.begin(), vcaSpillTracks_.end(), IsTrackPointerStale), vcaSpillTracks_.end());
 
+        // Routing cache -- drop everything if tracks came or went, and check the cached entries at a low rate to catch reordered sends
+        double now = DAW::GetCurrentNumberOfMilliseconds();
+        
+        if(GetNumTracks() != lastNumTracks_)
+            fxParamCache_.clear(); // don't hang on to entries for deleted tracks
+        
+        if(GetNumTracks() != lastNumTracks_ || now - lastRoutingVerifyTime_ > RoutingVerifyInterval)
+        {
+            for(auto it = trackNames_.begin(); it != trackNames_.end(); )
+            {
+                if(DAW::ValidateTrackPtr(it->first))
+                {
+                    RefreshTrackName(it->second, it->first);
+                    ++it;
+                }
+                else
+                    it = trackNames_.erase(it);
+            }
+            
+            for(auto it = trackColors_.begin(); it != trackColors_.end(); )
+            {
+                if(DAW::ValidateTrackPtr(it->first) && it->second.GetIsSameColor(ReadTrackColor(it->first)))
+                    ++it;
+                else
+                    it = trackColors_.erase(it);
+            }
+            
+            if(GetNumTracks() != lastNumTracks_)
+                trackRoutings_.clear();
+            else
+            {
+                for(auto it = trackRoutings_.begin(); it != trackRoutings_.end(); )
+                {
+                    if(GetIsTrackRoutingCurrent(it->first, it->second))
+                        ++it;
+                    else
+                        it = trackRoutings_.erase(it);
+                }
+            }
+            
+            lastNumTracks_ = GetNumTracks();
+            lastRoutingVerifyTime_ = now;
+        }
+        
+        int projectStateChangeCount = DAW::GetProjectStateChangeCount(nullptr);
+        
+        if(projectStateChangeCount != lastProjectStateChangeCount_)
+        {
+            trackColors_.clear();
+            lastProjectStateChangeCount_ = projectStateChangeCount;
+        }
+
         // Get Visible Tracks
         for (int i = 1; i <= GetNumTracks(); i++)
         {
@@ -1774,19 +2716,25 @@ public:
             
             if(DAW::IsTrackVisible(track, followMCP_))
             {
-                int maxSendSlot = DAW::GetTrackNumSends(track, 0) - 1;
+                int numSends = DAW::GetTrackNumSends(track, 0);
+                int maxSendSlot = numSends - 1;
                 if(maxSendSlot > maxSendSlot_)
                 {
                     maxSendSlot_ = maxSendSlot;
                     AdjustSendSlotBank(0);
                 }
              
-                int maxReceiveSlot = DAW::GetTrackNumSends(track, -1) - 1;
+                int numReceives = DAW::GetTrackNumSends(track, -1);
+                int maxReceiveSlot = numReceives - 1;
                 if(maxReceiveSlot > maxReceiveSlot_)
                 {
                     maxReceiveSlot_ = maxReceiveSlot;
                     AdjustReceiveSlotBank(0);
                 }
+                
+                // We already have the counts, so a routing change on a visible track is caught this tick
+                if(trackRoutings_.count(track) > 0 && (trackRoutings_[track].numSends != numSends || trackRoutings_[track].numReceives != numReceives))
+                    trackRoutings_.erase(track);
 
                 int maxFXMenuSlot = DAW::TrackFX_GetCount(track) - 1;
                 if(maxFXMenuSlot > maxFXMenuSlot_)
@@ -1872,6 +2820,10 @@ public:
     
     void EnterPage()
     {
+        trackRoutings_.clear(); // routing may have changed while another page was active
+        trackNames_.clear();
+        trackColors_.clear();
+        
         /*
          if(colourTracks_)
          {
@@ -1928,6 +2880,18 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct LastTouchedFX
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    bool isValid = false;
+    int trackNumber = 0;
+    int fxSlot = 0;
+    int paramIndex = 0;
+    MediaTrack* track = nullptr;
+    string paramName = "";
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class Page
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1949,6 +2913,86 @@ private:
 
     Navigator* defaultNavigator_ = nullptr;
     
+    int firstSurfaceToUpdate_ = 0;
+    
+    // Focused FX -- polled once per tick in Run and shared by every surface and the FocusedFXNavigator
+    int focusedFXState_ = 0;
+    int focusedFXTrackNumber_ = 0;
+    int focusedFXItemNumber_ = 0;
+    int focusedFXIndex_ = 0;
+    MediaTrack* focusedFXTrack_ = nullptr;
+    bool isFocusedFXChanged_ = false;
+    
+    void PollFocusedFX()
+    {
+        int trackNumber = 0;
+        int itemNumber = 0;
+        int fxIndex = 0;
+        
+        int state = DAW::GetFocusedFX2(&trackNumber, &itemNumber, &fxIndex);
+        
+        isFocusedFXChanged_ = state != focusedFXState_ || trackNumber != focusedFXTrackNumber_ || itemNumber != focusedFXItemNumber_ || fxIndex != focusedFXIndex_;
+        
+        focusedFXState_ = state;
+        focusedFXTrackNumber_ = trackNumber;
+        focusedFXItemNumber_ = itemNumber;
+        focusedFXIndex_ = fxIndex;
+        
+        if(state == 1) // Track FX
+            focusedFXTrack_ = DAW::GetTrack(trackNumber);
+        else
+            focusedFXTrack_ = nullptr;
+    }
+    
+    // Last touched FX param -- polled once per tick in Run, the param name is only refetched when the param changes,
+    // the value is fetched on the first request each tick and shared by every context on every surface
+    LastTouchedFX lastTouchedFX_;
+    bool isLastTouchedFXChanged_ = false;
+    bool hasLastTouchedFXValue_ = false;
+    double lastTouchedFXNormalizedValue_ = 0.0;
+    string lastTouchedFXFormattedValue_ = "";
+    
+    void PollLastTouchedFX()
+    {
+        LastTouchedFX lastTouchedFX;
+        
+        lastTouchedFX.isValid = DAW::GetLastTouchedFX(&lastTouchedFX.trackNumber, &lastTouchedFX.fxSlot, &lastTouchedFX.paramIndex);
+        
+        if(lastTouchedFX.isValid)
+            lastTouchedFX.track = DAW::GetTrack(lastTouchedFX.trackNumber);
+        
+        isLastTouchedFXChanged_ =  lastTouchedFX.isValid != lastTouchedFX_.isValid
+                                || lastTouchedFX.track != lastTouchedFX_.track
+                                || lastTouchedFX.fxSlot != lastTouchedFX_.fxSlot
+                                || lastTouchedFX.paramIndex != lastTouchedFX_.paramIndex;
+        
+        if( ! isLastTouchedFXChanged_)
+            lastTouchedFX.paramName = lastTouchedFX_.paramName;
+        else if(lastTouchedFX.track != nullptr)
+            lastTouchedFX.paramName = trackNavigationManager_->GetFXParamName(lastTouchedFX.track, lastTouchedFX.fxSlot, lastTouchedFX.paramIndex);
+        
+        lastTouchedFX_ = lastTouchedFX;
+        hasLastTouchedFXValue_ = false;
+    }
+    
+    void ReadLastTouchedFXValue()
+    {
+        if(hasLastTouchedFXValue_)
+            return;
+        
+        hasLastTouchedFXValue_ = true;
+        lastTouchedFXNormalizedValue_ = 0.0;
+        lastTouchedFXFormattedValue_ = "";
+        
+        if(MediaTrack* track = lastTouchedFX_.track)
+        {
+            double min = 0.0;
+            double max = 0.0;
+            lastTouchedFXNormalizedValue_ = DAW::TrackFX_GetParam(track, lastTouchedFX_.fxSlot, lastTouchedFX_.paramIndex, &min, &max);
+            lastTouchedFXFormattedValue_ = trackNavigationManager_->GetFormattedFXParamValue(track, lastTouchedFX_.fxSlot, lastTouchedFX_.paramIndex);
+        }
+    }
+    
 public:
     Page(string name, bool followMCP, bool synchPages, bool scrollLink, int numChannels) : name_(name),  trackNavigationManager_(new TrackNavigationManager(this, followMCP, synchPages, scrollLink, numChannels)), defaultNavigator_(new Navigator(this)) { }
     
@@ -1966,6 +3010,7 @@ public:
     
     string GetName() { return name_; }
     TrackNavigationManager* GetTrackNavigationManager() { return trackNavigationManager_; }
+    const vector<ControlSurface*> &GetSurfaces() { return surfaces_; }
     
     bool GetShift() { return isShift_; }
     bool GetOption() { return isOption_; }
@@ -1974,6 +3019,42 @@ public:
 
     Navigator* GetDefaultNavigator() { return defaultNavigator_; }
     
+    bool GetIsFocusedFXChanged() { return isFocusedFXChanged_; } // set for the one tick the focused FX changed on
+    int GetFocusedFXState() { return focusedFXState_; }
+    int GetFocusedFXTrackNumber() { return focusedFXTrackNumber_; }
+    int GetFocusedFXIndex() { return focusedFXIndex_; }
+    MediaTrack* GetFocusedFXTrack() { return focusedFXTrack_; }
+    
+    const LastTouchedFX &GetLastTouchedFX() { return lastTouchedFX_; }
+    bool GetIsLastTouchedFXChanged() { return isLastTouchedFXChanged_; }
+    
+    double GetLastTouchedFXNormalizedValue()
+    {
+        ReadLastTouchedFXValue();
+        return lastTouchedFXNormalizedValue_;
+    }
+    
+    string GetLastTouchedFXFormattedValue()
+    {
+        ReadLastTouchedFXValue();
+        return lastTouchedFXFormattedValue_;
+    }
+    
+    void SetLastTouchedFXParam(double value)
+    {
+        if(MediaTrack* track = lastTouchedFX_.track)
+        {
+            DAW::TrackFX_SetParam(track, lastTouchedFX_.fxSlot, lastTouchedFX_.paramIndex, value);
+            hasLastTouchedFXValue_ = false; // re-read, REAPER may have snapped the value
+        }
+    }
+    
+    void EndLastTouchedFXParamEdit()
+    {
+        if(MediaTrack* track = lastTouchedFX_.track)
+            DAW::TrackFX_EndParamEdit(track, lastTouchedFX_.fxSlot, lastTouchedFX_.paramIndex);
+    }
+    
     void InitializeEuCon()
     {
         for(auto surface : surfaces_)
@@ -2256,15 +3337,42 @@ public:
     */
 
 
-    void Run()
+    void Run(int updateBudget)
     {
         trackNavigationManager_->RebuildTrackList();
         
+        PollFocusedFX();
+        PollLastTouchedFX();
+        
+        // Input is never budgeted
         for(auto surface : surfaces_)
             surface->HandleExternalInput();
         
+        if(surfaces_.size() == 0)
+            return;
+        
+        double updateDeadline = 0.0;
+        
+        if(updateBudget > 0)
+            updateDeadline = DAW::GetCurrentNumberOfMilliseconds() + updateBudget;
+        
+        // Rotate the starting surface so the first one in CSI.ini can't eat the whole budget every tick
+        if(firstSurfaceToUpdate_ >= (int)surfaces_.size())
+            firstSurfaceToUpdate_ = 0;
+        
+        for(int i = 0; i < (int)surfaces_.size(); i++)
+            surfaces_[(firstSurfaceToUpdate_ + i) % surfaces_.size()]->RequestUpdate(updateDeadline);
+        
+        if(updateBudget > 0)
+            firstSurfaceToUpdate_++;
+    }
+    
+    void ReportUpdateStatistics()
+    {
         for(auto surface : surfaces_)
-            surface->RequestUpdate();
+            surface->ReportUpdateStatistics();
+        
+        trackNavigationManager_->ReportFXQueryCounts();
     }
 
     void ForceClearAllWidgets()
@@ -2356,6 +3464,11 @@ public:
         trackNavigationManager_->OnTrackListChange();
     }
     
+    void OnTrackNameChange(MediaTrack* track, const char* title)
+    {
+        trackNavigationManager_->OnTrackNameChange(track, title);
+    }
+    
     void OnTrackSelectionBySurface(MediaTrack* track)
     {
         trackNavigationManager_->OnTrackSelectionBySurface(track);
@@ -2372,22 +3485,30 @@ public:
 
     void TrackFXListChanged(MediaTrack* track)
     {
+        trackNavigationManager_->OnTrackFXListChanged(track);
+        
         for(auto surface : surfaces_)
             surface->TrackFXListChanged();
     }
 
-    void EnterPage()
+    void EnterPage(Page* previousPage)
     {
         trackNavigationManager_->EnterPage();
         
+        // Surfaces that were on the previous page pick up where it left off, so only the differences get sent
         for(auto surface : surfaces_)
-            surface->ClearCache();
+        {
+            if(ControlSurface* previousSurface = previousPage->GetSurfaceByName(surface->GetName()))
+                surface->CopyCacheFrom(previousSurface);
+            else
+                surface->ClearCache();
+        }
         
         for(auto surface : surfaces_)
             surface->OnPageEnter();
     }
     
-    void LeavePage()
+    void LeavePage(Page* nextPage)
     {
         trackNavigationManager_->LeavePage();
         
@@ -2395,7 +3516,27 @@ public:
             surface->OnPageLeave();
 
         for(auto surface : surfaces_)
-            surface->ClearCache();        
+            if(nextPage->GetSurfaceByName(surface->GetName()) == nullptr)
+                surface->ClearCache();
+    }
+    
+    ControlSurface* GetSurfaceByName(string name)
+    {
+        for(auto surface : surfaces_)
+            if(surface->GetName() == name)
+                return surface;
+        
+        return nullptr;
+    }
+    
+    int GetNumMessagesSent()
+    {
+        int numMessagesSent = 0;
+        
+        for(auto surface : surfaces_)
+            numMessagesSent += surface->GetNumMessagesSent();
+        
+        return numMessagesSent;
     }
     
     void OnInitialization()
@@ -2405,6 +3546,166 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class FXParamFileWriter
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Writes the ZoneRawFXFiles off the UI thread. Pending writes are keyed by path, so an FX
+    // queued several times before the worker wakes up is only written once, with the latest contents.
+private:
+    map<string, string> pendingWrites_;
+    mutex mutex_;
+    condition_variable condition_;
+    thread thread_;
+    bool shouldStop_ = false;
+    
+    const int coalesceDelay_ = 250; // milliseconds -- lets a burst of FX list changes collapse into one write per FX
+    
+    void WriteFiles()
+    {
+        unique_lock<mutex> lock(mutex_);
+        
+        while(true)
+        {
+            condition_.wait(lock, [this] { return shouldStop_ || pendingWrites_.size() > 0; });
+            
+            if( ! shouldStop_)
+                condition_.wait_for(lock, chrono::milliseconds(coalesceDelay_), [this] { return shouldStop_; });
+            
+            map<string, string> writes;
+            writes.swap(pendingWrites_);
+            
+            lock.unlock();
+            
+            for(auto [path, contents] : writes)
+            {
+                ofstream fxFile(path);
+                
+                if(fxFile.is_open())
+                    fxFile << contents;
+            }
+            
+            lock.lock();
+            
+            if(shouldStop_ && pendingWrites_.size() == 0)
+                return;
+        }
+    }
+    
+public:
+    ~FXParamFileWriter()
+    {
+        if(thread_.joinable())
+        {
+            {
+                lock_guard<mutex> lock(mutex_);
+                shouldStop_ = true;
+            }
+            
+            condition_.notify_one();
+            thread_.join();
+        }
+    }
+    
+    void QueueWrite(string path, string contents)
+    {
+        {
+            lock_guard<mutex> lock(mutex_);
+            pendingWrites_[path] = contents;
+        }
+        
+        if( ! thread_.joinable())
+            thread_ = thread(&FXParamFileWriter::WriteFiles, this);
+        
+        condition_.notify_one();
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct ReloadedFile
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    string filePath = "";
+    shared_ptr<const ParsedZone> parsedZone = nullptr; // nullptr for surface (.mst/.ost) files, those re-initialise CSI
+    chrono::steady_clock::time_point detectedTime;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct ParsedZoneBatch
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Zones parsed in one pass, published to the ZonePreloader together so each of its maps is copied once per pass
+    map<string, shared_ptr<const ParsedZone>> parsedZones;
+    map<string, shared_ptr<const ParsedZone>> parsedZonesByContent;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ZonePreloader
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // The one store of parsed .zon files for the whole process, shared by every surface on every page.
+    // Files can be parsed on a worker thread ahead of first use. The parsed zones are immutable and published
+    // as a whole new map with an atomic swap, so GetParsedZone never blocks the UI thread.
+    // Parsed zones are also indexed by file contents, so identical files in different zone folders are parsed once.
+    // Writers collect a ParsedZoneBatch and publish it in one go, so a pass over many files copies each map once.
+    // The same thread stats the watched files every ZoneFileCheckInterval and reparses the ones that changed,
+    // the UI thread picks those up with TakeReloadedFiles and swaps them into the surfaces.
+private:
+    shared_ptr<const map<string, shared_ptr<const ParsedZone>>> parsedZones_;
+    shared_ptr<const map<string, shared_ptr<const ParsedZone>>> parsedZonesByContent_;
+    mutex publishMutex_;
+    
+    map<string, string> zoneNames_; // file path -> Zone name, filled by PreProcessZoneFile on the UI thread
+    
+    vector<string> pendingFilePaths_;
+    mutex mutex_;
+    condition_variable condition_;
+    thread thread_;
+    bool shouldStop_ = false;
+    
+    map<string, pair<int64_t, int64_t>> watchedFiles_; // file path -> size, modification time in ns
+    vector<ReloadedFile> reloadedFiles_;
+    atomic<bool> hasReloadedFiles_ { false };
+    chrono::steady_clock::time_point lastFileCheckTime_;
+    
+    atomic<int> numHits_ { 0 };
+    atomic<int> numMisses_ { 0 };
+    
+    void ParseFiles();
+    void CheckWatchedFiles(const map<string, pair<int64_t, int64_t>> &watchedFiles);
+    void StartThread();
+    
+public:
+    ZonePreloader();
+    ~ZonePreloader();
+    
+    static void SetCacheFolder(const string &folder); // where compiled zones are kept, "" for none
+    
+    void Preload(const vector<string> &filePaths);
+    shared_ptr<const ParsedZone> LoadZoneFile(const string &filePath); // from the store, or parsed (or read compiled) now on this thread
+    shared_ptr<const ParsedZone> GetParsedZone(string filePath); // nullptr if the file has not been parsed yet
+    shared_ptr<const ParsedZone> GetParsedZoneByContent(const string &contentKey); // nullptr if no file with these contents has been parsed
+    void PublishParsedZones(const ParsedZoneBatch &batch);
+    void Clear();
+    
+    bool GetZoneName(const string &filePath, string &zoneName)
+    {
+        if(zoneNames_.count(filePath) == 0)
+            return false;
+        
+        zoneName = zoneNames_[filePath];
+        return true;
+    }
+    
+    void AddZoneName(const string &filePath, const string &zoneName) { zoneNames_[filePath] = zoneName; }
+    
+    void WatchFile(const string &filePath, int64_t fileSize, int64_t fileTime);
+    bool TakeReloadedFiles(vector<ReloadedFile> &reloadedFiles);
+    
+    int GetNumHits() { return numHits_; }
+    int GetNumMisses() { return numMisses_; }
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class Manager
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2419,13 +3720,23 @@ private:
     map<string, map<string, int>> fxParamIndices_;
     
     int currentPageIndex_ = 0;
+    
+    Page* pageSwitchedFrom_ = nullptr;
+    int pageSwitchMessageBase_ = 0;
+    int lastPageSwitchMessageCount_ = 0;
+    
     bool surfaceInDisplay_ = false;
     bool surfaceOutDisplay_ = false;
     bool fxParamsDisplay_ = false;
     bool fxParamsWrite_ = false;
+    
+    FXParamFileWriter fxParamFileWriter_;
+    ZonePreloader zonePreloader_;
 
     bool shouldRun_ = true;
     
+    int updateBudget_ = 0; // milliseconds per tick for widget feedback, 0 == unlimited
+    
     int *timeModePtr_ = nullptr;
     int *timeMode2Ptr_ = nullptr;
     int *measOffsPtr_ = nullptr;
@@ -2502,6 +3813,8 @@ public:
     void ToggleFXParamsDisplay() { fxParamsDisplay_ = ! fxParamsDisplay_;  }
     void ToggleFXParamsWrite() { fxParamsWrite_ = ! fxParamsWrite_;  }
 
+    int GetUpdateBudget() { return updateBudget_; }
+    
     bool GetSurfaceInDisplay() { return surfaceInDisplay_;  }
     bool GetSurfaceOutDisplay() { return surfaceOutDisplay_;  }
     
@@ -2516,12 +3829,12 @@ public:
     double *GetTimeOffsPtr() { return timeOffsPtr_; }
     int GetProjectPanMode() { return *projectPanModePtr_; }
    
-    ActionContext GetActionContext(string actionName, Widget* widget, Zone* zone, vector<string> params, vector<vector<string>> properties)
+    ActionContext GetActionContext(string actionName, Widget* widget, Zone* zone, const vector<string> &params, shared_ptr<const ActionContextValues> values)
     {      
         if(actions_.count(actionName) > 0)
-            return ActionContext(actions_[actionName], widget, zone, params, properties);
+            return ActionContext(actions_[actionName], widget, zone, params, values);
         else
-            return ActionContext(actions_["NoAction"], widget, zone, params, properties);
+            return ActionContext(actions_["NoAction"], widget, zone, params, values);
     }
 
     void OnTrackSelection(MediaTrack *track)
@@ -2536,6 +3849,18 @@ public:
             pages_[currentPageIndex_]->OnTrackListChange();
     }
     
+    void OnTrackNameChange(MediaTrack* track, const char* title)
+    {
+        for(auto page : pages_)
+            page->OnTrackNameChange(track, title);
+    }
+    
+    ZonePreloader* GetZonePreloader() { return &zonePreloader_; }
+    void AddFXZoneFilePaths(MediaTrack* track, unordered_set<string> &filePathSet, vector<string> &filePaths);
+    void PreloadFXZones();
+    void PreloadFXZones(MediaTrack* track);
+    void ApplyReloadedFiles();
+    
     void OnFXFocus(MediaTrack *track, int fxIndex)
     {
         if(pages_.size() > 0)
@@ -2607,14 +3932,31 @@ public:
                     page->GetTrackNavigationManager()->AdjustFXMenuSlotBank(originatingSurface, amount);
     }
     
+    void SwitchPage(int pageIndex)
+    {
+        Page* previousPage = pages_[currentPageIndex_];
+        Page* nextPage = pages_[pageIndex];
+        
+        pageSwitchedFrom_ = previousPage;
+        pageSwitchMessageBase_ = GetPageSwitchMessagesSent(nextPage);
+        
+        previousPage->LeavePage(nextPage);
+        currentPageIndex_ = pageIndex;
+        nextPage->EnterPage(previousPage);
+    }
+    
+    int GetPageSwitchMessagesSent(Page* nextPage)
+    {
+        if(pageSwitchedFrom_ == nextPage)
+            return nextPage->GetNumMessagesSent();
+        else
+            return pageSwitchedFrom_->GetNumMessagesSent() + nextPage->GetNumMessagesSent();
+    }
+    
     void NextPage()
     {
         if(pages_.size() > 0)
-        {
-            pages_[currentPageIndex_]->LeavePage();
-            currentPageIndex_ = currentPageIndex_ == pages_.size() - 1 ? 0 : ++currentPageIndex_;
-            pages_[currentPageIndex_]->EnterPage();
-        }
+            SwitchPage(currentPageIndex_ == pages_.size() - 1 ? 0 : currentPageIndex_ + 1);
     }
     
     void GoToPage(string pageName)
@@ -2623,15 +3965,19 @@ public:
         {
             if(pages_[i]->GetName() == pageName)
             {
-                pages_[currentPageIndex_]->LeavePage();
-                currentPageIndex_ = i;
-                pages_[currentPageIndex_]->EnterPage();
-                
+                SwitchPage(i);
                 break;
             }
         }
     }
     
+    void ForceFullRefresh()
+    {
+        // For devices that lost state -- zero everything, the next update resends whatever isn't zero
+        if(pages_.size() > 0)
+            pages_[currentPageIndex_]->ForceClearAllWidgets();
+    }
+    
     bool GetTouchState(MediaTrack* track, int touchedControl)
     {
         if(pages_.size() > 0)
@@ -2645,46 +3991,31 @@ public:
         for(auto & page : pages_)
             page->TrackFXListChanged(track);
         
+        PreloadFXZones(track);
+        
         if(fxParamsDisplay_ || fxParamsWrite_)
         {
             char fxName[BUFSZ];
             char fxParamName[BUFSZ];
             
-            ofstream fxFile;
-            
             for(int i = 0; i < DAW::TrackFX_GetCount(track); i++)
             {
                 DAW::TrackFX_GetFXName(track, i, fxName, sizeof(fxName));
                 
-                if(fxParamsDisplay_)
-                    DAW::ShowConsoleMsg(("Zone \"" + string(fxName) + "\"").c_str());
-                
-                if(fxParamsWrite_)
-                {
-                    string fxNameNoBadChars(fxName);
-                    fxNameNoBadChars = regex_replace(fxNameNoBadChars, regex(BadFileChars), "_");
-
-                    fxFile.open(string(DAW::GetResourcePath()) + "/CSI/Zones/ZoneRawFXFiles/" + fxNameNoBadChars + ".txt");
-                    
-                    if(fxFile.is_open())
-                        fxFile << "Zone \"" + string(fxName) + "\"" + GetLineEnding();
-                }
-
-                if(fxParamsDisplay_)
-                    DAW::ShowConsoleMsg("\n\n\tSelectedTrackNavigator\n");
+                // REAPER has to be queried here on the UI thread, but everything else is gathered into buffers --
+                // one ShowConsoleMsg per FX, and the file itself is written by fxParamFileWriter_
+                string consoleText = "Zone \"" + string(fxName) + "\"\n\n\tSelectedTrackNavigator\n";
+                string fileText = "Zone \"" + string(fxName) + "\"" + GetLineEnding() + "\tSelectedTrackNavigator" + GetLineEnding();
                 
-                if(fxParamsWrite_ && fxFile.is_open())
-                    fxFile << "\tSelectedTrackNavigator" + GetLineEnding();
-
                 for(int j = 0; j < DAW::TrackFX_GetNumParams(track, i); j++)
                 {
                     DAW::TrackFX_GetParamName(track, i, j, fxParamName, sizeof(fxParamName));
 
                     if(fxParamsDisplay_)
-                        DAW::ShowConsoleMsg(("\n\tFXParam " + to_string(j) + " \"" + string(fxParamName) + "\"").c_str());
+                        consoleText += "\n\tFXParam " + to_string(j) + " \"" + string(fxParamName) + "\"";
   
-                    if(fxParamsWrite_ && fxFile.is_open())
-                        fxFile <<  "\tFXParam " + to_string(j) + " \"" + string(fxParamName)+ "\"" + GetLineEnding();
+                    if(fxParamsWrite_)
+                        fileText += "\tFXParam " + to_string(j) + " \"" + string(fxParamName)+ "\"" + GetLineEnding();
                         
                     /* step sizes
                     double stepOut = 0;
@@ -2693,17 +4024,24 @@ public:
                     bool istoggleOut = false;
                     TrackFX_GetParameterStepSizes(track, i, j, &stepOut, &smallstepOut, &largestepOut, &istoggleOut);
 
-                    DAW::ShowConsoleMsg(("\n\n" + to_string(j) + " - \"" + string(fxParamName) + "\"\t\t\t\t Step = " +  to_string(stepOut) + " Small Step = " + to_string(smallstepOut)  + " LargeStep = " + to_string(largestepOut)  + " Toggle Out = " + (istoggleOut == 0 ? "false" : "true")).c_str());
+                    consoleText += "\n\n" + to_string(j) + " - \"" + string(fxParamName) + "\"\t\t\t\t Step = " +  to_string(stepOut) + " Small Step = " + to_string(smallstepOut)  + " LargeStep = " + to_string(largestepOut)  + " Toggle Out = " + (istoggleOut == 0 ? "false" : "true");
                     */
                 }
                 
                 if(fxParamsDisplay_)
-                    DAW::ShowConsoleMsg("\nZoneEnd\n\n");
+                {
+                    consoleText += "\nZoneEnd\n\n";
+                    DAW::ShowConsoleMsg(consoleText.c_str());
+                }
 
-                if(fxParamsWrite_ && fxFile.is_open())
+                if(fxParamsWrite_)
                 {
-                    fxFile << "ZoneEnd";
-                    fxFile.close();
+                    fileText += "ZoneEnd";
+                    
+                    string fxNameNoBadChars(fxName);
+                    fxNameNoBadChars = regex_replace(fxNameNoBadChars, regex(BadFileChars), "_");
+                    
+                    fxParamFileWriter_.QueueWrite(string(DAW::GetResourcePath()) + "/CSI/Zones/ZoneRawFXFiles/" + fxNameNoBadChars + ".txt", fileText);
                 }
             }
         }
@@ -2715,14 +4053,46 @@ public:
             pages_[currentPageIndex_]->InitializeEuCon();
     }
     
+    void ReportUpdateStatistics()
+    {
+        if(pages_.size() > 0)
+            pages_[currentPageIndex_]->ReportUpdateStatistics();
+        
+        char buffer[250];
+        snprintf(buffer, sizeof(buffer), "Last page switch sent %d messages\n", lastPageSwitchMessageCount_);
+        DAW::ShowConsoleMsg(buffer);
+        
+        snprintf(buffer, sizeof(buffer), "Zone preloader -- %d preloaded, %d parsed lazily\n", zonePreloader_.GetNumHits(), zonePreloader_.GetNumMisses());
+        DAW::ShowConsoleMsg(buffer);
+    }
+    
     //int repeats = 0;
     
     void Run()
     {
         //int start = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
         
+        if(shouldRun_)
+            ApplyReloadedFiles(); // may re-initialise, so before pages_ is looked at
+        
         if(shouldRun_ && pages_.size() > 0)
-            pages_[currentPageIndex_]->Run();
+        {
+            pages_[currentPageIndex_]->Run(updateBudget_);
+            
+            // A page switch costs what Leave/Enter sent plus the first update on the new page
+            if(pageSwitchedFrom_ != nullptr)
+            {
+                lastPageSwitchMessageCount_ = GetPageSwitchMessagesSent(pages_[currentPageIndex_]) - pageSwitchMessageBase_;
+                pageSwitchedFrom_ = nullptr;
+                
+                if(surfaceOutDisplay_)
+                {
+                    char buffer[250];
+                    snprintf(buffer, sizeof(buffer), "Page switch to %s sent %d messages\n", pages_[currentPageIndex_]->GetName().c_str(), lastPageSwitchMessageCount_);
+                    DAW::ShowConsoleMsg(buffer);
+                }
+            }
+        }
         /*
          repeats++;
          
@@ -81,6 +81,8 @@ public:
 
     static const char* GetResourcePath() { return ::GetResourcePath(); }
     
+    static int RecursiveCreateDirectory(const char* path, size_t ignored) { return ::RecursiveCreateDirectory(path, ignored); }
+    
     static int NamedCommandLookup(const char* command_name) { return ::NamedCommandLookup(command_name);  }
 
     static void SendCommandMessage(WPARAM wparam) { ::SendMessage(g_hwnd, WM_COMMAND, wparam, 0); }
@@ -140,6 +142,8 @@ public:
 
     static bool ValidateTrackPtr(MediaTrack* track) { return ValidatePtr(track, "MediaTrack*"); }
     
+    static int GetProjectStateChangeCount(ReaProject* proj) { return ::GetProjectStateChangeCount(proj); }
+    
     static MediaTrack* GetTrack(int trackidx)
     {
         trackidx--;
@@ -158,6 +162,14 @@ public:
             return 0;
     }
     
+    static GUID* TrackFX_GetFXGUID(MediaTrack* track, int fx)
+    {
+        if(ValidatePtr(track, "MediaTrack*"))
+            return ::TrackFX_GetFXGUID(track, fx);
+        else
+            return nullptr;
+    }
+    
     static bool TrackFX_GetFXName(MediaTrack* track, int fx, char* buf, int buf_sz)
     {
         if(ValidatePtr(track, "MediaTrack*"))
@@ -222,6 +234,14 @@ public:
             return 0.0;
     }
     
+    static double TrackFX_GetParamNormalized(MediaTrack* track, int fx, int param)
+    {
+        if(ValidatePtr(track, "MediaTrack*"))
+            return ::TrackFX_GetParamNormalized(track, fx, param);
+        else
+            return 0.0;
+    }
+    
     static bool TrackFX_SetParam(MediaTrack* track, int fx, int param, double val)
     {
         if(ValidatePtr(track, "MediaTrack*"))
@@ -76,6 +76,12 @@ void CSurfIntegrator::SetTrackListChange()
         TheManager->OnTrackListChange();
 }
 
+void CSurfIntegrator::SetTrackTitle(MediaTrack *trackid, const char *title)
+{
+    if(TheManager)
+        TheManager->OnTrackNameChange(trackid, title);
+}
+
 int CSurfIntegrator::Extended(int call, void *parm1, void *parm2, void *parm3)
 {
     if(call == CSURF_EXT_SUPPORTS_EXTENDED_TOUCH)
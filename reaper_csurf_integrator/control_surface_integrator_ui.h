@@ -23,6 +23,7 @@ public:
     CSurfIntegrator();
     ~CSurfIntegrator();
     virtual void SetTrackListChange() override;
+    virtual void SetTrackTitle(MediaTrack *trackid, const char *title) override;
     virtual void OnTrackSelection(MediaTrack *trackid) override;
     virtual int Extended(int call, void *parm1, void *parm2, void *parm3) override;
     virtual bool GetTouchState(MediaTrack *trackid, int touchedControl) override;
@@ -178,6 +178,36 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class FullRefresh : public Action
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+public:
+    virtual string GetName() override { return "FullRefresh"; }
+    
+    void Do(ActionContext*, double value) override
+    {
+        if(value == 0.0) return; // ignore button releases
+        
+        TheManager->ForceFullRefresh();
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ShowUpdateStatistics : public Action
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+public:
+    virtual string GetName() override { return "ShowUpdateStatistics"; }
+    
+    void Do(ActionContext*, double value) override
+    {
+        if(value == 0.0) return; // ignore button releases
+        
+        TheManager->ReportUpdateStatistics();
+    }
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class GoZone : public Action
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -138,17 +138,102 @@ public:
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct EncoderAccelerationTable
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Acceleration index for every possible CC value, -1 where the value isn't one this encoder sends
+    int increment[128];
+    int decrement[128];
+    
+    EncoderAccelerationTable()
+    {
+        fill(begin(increment), end(increment), -1);
+        fill(begin(decrement), end(decrement), -1);
+    }
+    
+    static void SetIndices(int (&indices)[128], const vector<int> &values)
+    {
+        for(int i = 0; i < (int)values.size(); i++)
+            if(values[i] >= 0 && values[i] < 128)
+                indices[values[i]] = i;
+    }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class EncoderVelocityCurve
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Optional, picks the acceleration index from the time between detents instead of from the CC value.
+    // Defined on the .mst line as descending ms thresholds, e.g. Velocity 120 80 50 30 -- slower than 120 ms is index 0,
+    // under 120 is index 1 and so on.
+private:
+    static const int MaxInterval = 256; // ms, anything at least this slow is the first step
+    
+    vector<int> indicesByInterval_; // built once from the thresholds, one entry per ms
+    
+    double lastDetentTime_ = 0.0;
+    double lastInterval_ = MaxInterval;
+    bool lastWasIncrement_ = true;
+    
+public:
+    EncoderVelocityCurve(const vector<string> &params)
+    {
+        auto velocity = find(params.begin(), params.end(), "Velocity");
+        
+        if(velocity == params.end())
+            return;
+        
+        vector<double> thresholds;
+        
+        for(auto it = velocity + 1; it != params.end() && regex_match(*it, regex("[0-9]+([.][0-9]+)?")); ++it)
+            thresholds.push_back(stod(*it));
+        
+        if(thresholds.size() == 0)
+            return;
+        
+        for(int interval = 0; interval < MaxInterval; interval++)
+        {
+            int index = 0;
+            
+            for(auto threshold : thresholds)
+                if(interval < threshold)
+                    index++;
+            
+            indicesByInterval_.push_back(index);
+        }
+    }
+    
+    bool GetIsEnabled() { return indicesByInterval_.size() > 0; }
+    
+    int GetAccelerationIndex(bool isIncrement, double now)
+    {
+        double interval = now - lastDetentTime_;
+        
+        if(isIncrement != lastWasIncrement_)
+            interval = MaxInterval; // a change of direction starts slow again
+        else if(interval < 1.0)
+            interval = lastInterval_; // several detents in the same input batch, keep the current speed
+        
+        lastDetentTime_ = now;
+        lastInterval_ = interval;
+        lastWasIncrement_ = isIncrement;
+        
+        return indicesByInterval_[interval >= MaxInterval ? MaxInterval - 1 : int(interval)];
+    }
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class AcceleratedEncoder_Midi_CSIMessageGenerator : public Midi_CSIMessageGenerator
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 {
 private:
-    map<int, int> accelerationIndicesForIncrement_;
-    map<int, int> accelerationIndicesForDecrement_;
+    EncoderAccelerationTable accelerationIndices_;
+    EncoderVelocityCurve velocityCurve_;
 
 public:
     virtual ~AcceleratedEncoder_Midi_CSIMessageGenerator() {}
-    AcceleratedEncoder_Midi_CSIMessageGenerator(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* message, vector<string> params) : Midi_CSIMessageGenerator(widget)
+    AcceleratedEncoder_Midi_CSIMessageGenerator(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* message, vector<string> params) : Midi_CSIMessageGenerator(widget), velocityCurve_(params)
     {
         surface->AddCSIMessageGenerator(message->midi_message[0] * 0x10000 + message->midi_message[1] * 0x100, this);
         
@@ -218,29 +303,14 @@ public:
                     decValues.push_back(strtol(strVal.c_str(), nullptr, 16));
             }
             
-            if(incValues.size() > 0)
-            {
-                if(incValues.size() == 1)
-                    accelerationIndicesForIncrement_[incValues[0]] = 0;
-                else
-                    for(int i = 0; i < incValues.size(); i++)
-                        accelerationIndicesForIncrement_[incValues[i]] = i;
-            }
-            
-            if(decValues.size() > 0)
-            {
-                if(decValues.size() == 1)
-                    accelerationIndicesForDecrement_[decValues[0]] = 0;
-                else
-                    for(int i = 0; i < decValues.size(); i++)
-                        accelerationIndicesForDecrement_[decValues[i]] = i;
-            }
+            EncoderAccelerationTable::SetIndices(accelerationIndices_.increment, incValues);
+            EncoderAccelerationTable::SetIndices(accelerationIndices_.decrement, decValues);
         }
     }
     
     virtual void ProcessMidiMessage(const MIDI_event_ex_t* midiMessage) override
     {
-        int val = midiMessage->midi_message[2];
+        int val = midiMessage->midi_message[2] & 0x7f;
 
         double delta = (midiMessage->midi_message[2] & 0x3f) / 63.0;
         
@@ -249,11 +319,18 @@ public:
         
         delta = delta / 2.0;
 
-        if(accelerationIndicesForIncrement_.count(val) > 0)
-            widget_->QueueRelativeAction(accelerationIndicesForIncrement_[val], delta);
+        int accelerationIndex = accelerationIndices_.increment[val];
+        
+        if(accelerationIndex < 0)
+            accelerationIndex = accelerationIndices_.decrement[val];
+        
+        if(accelerationIndex < 0)
+            return;
         
-        else if(accelerationIndicesForDecrement_.count(val) > 0)
-            widget_->QueueRelativeAction(accelerationIndicesForDecrement_[val], delta);
+        if(velocityCurve_.GetIsEnabled())
+            accelerationIndex = velocityCurve_.GetAccelerationIndex(delta > 0, DAW::GetCurrentNumberOfMilliseconds());
+        
+        widget_->QueueRelativeAction(accelerationIndex, delta);
     }
 };
 
@@ -262,49 +339,39 @@ class MFT_AcceleratedEncoder_Midi_CSIMessageGenerator : public Midi_CSIMessageGe
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 {
 private:
-    map<int, int> accelerationIndicesForIncrement_;
-    map<int, int> accelerationIndicesForDecrement_;
+    EncoderAccelerationTable accelerationIndices_;
+    EncoderVelocityCurve velocityCurve_;
     
 public:
     virtual ~MFT_AcceleratedEncoder_Midi_CSIMessageGenerator() {}
-    MFT_AcceleratedEncoder_Midi_CSIMessageGenerator(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* message, vector<string> params) : Midi_CSIMessageGenerator(widget)
+    MFT_AcceleratedEncoder_Midi_CSIMessageGenerator(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* message, vector<string> params) : Midi_CSIMessageGenerator(widget), velocityCurve_(params)
     {
         surface->AddCSIMessageGenerator(message->midi_message[0] * 0x10000 + message->midi_message[1] * 0x100, this);
     
-        accelerationIndicesForDecrement_[0x3f] = 0;
-        accelerationIndicesForDecrement_[0x3e] = 1;
-        accelerationIndicesForDecrement_[0x3d] = 2;
-        accelerationIndicesForDecrement_[0x3c] = 3;
-        accelerationIndicesForDecrement_[0x3b] = 4;
-        accelerationIndicesForDecrement_[0x3a] = 5;
-        accelerationIndicesForDecrement_[0x39] = 6;
-        accelerationIndicesForDecrement_[0x38] = 7;
-        accelerationIndicesForDecrement_[0x36] = 8;
-        accelerationIndicesForDecrement_[0x33] = 9;
-        accelerationIndicesForDecrement_[0x2f] = 10;
-
-        accelerationIndicesForIncrement_[0x41] = 0;
-        accelerationIndicesForIncrement_[0x42] = 1;
-        accelerationIndicesForIncrement_[0x43] = 2;
-        accelerationIndicesForIncrement_[0x44] = 3;
-        accelerationIndicesForIncrement_[0x45] = 4;
-        accelerationIndicesForIncrement_[0x46] = 5;
-        accelerationIndicesForIncrement_[0x47] = 6;
-        accelerationIndicesForIncrement_[0x48] = 7;
-        accelerationIndicesForIncrement_[0x4a] = 8;
-        accelerationIndicesForIncrement_[0x4d] = 9;
-        accelerationIndicesForIncrement_[0x51] = 10;
+        EncoderAccelerationTable::SetIndices(accelerationIndices_.decrement, { 0x3f, 0x3e, 0x3d, 0x3c, 0x3b, 0x3a, 0x39, 0x38, 0x36, 0x33, 0x2f });
+        EncoderAccelerationTable::SetIndices(accelerationIndices_.increment, { 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x4a, 0x4d, 0x51 });
     }
     
     virtual void ProcessMidiMessage(const MIDI_event_ex_t* midiMessage) override
     {
-        int val = midiMessage->midi_message[2];
+        int val = midiMessage->midi_message[2] & 0x7f;
+        
+        double delta = 0.001;
+        int accelerationIndex = accelerationIndices_.increment[val];
         
-        if(accelerationIndicesForIncrement_.count(val) > 0)
-            widget_->QueueRelativeAction(accelerationIndicesForIncrement_[val], 0.001);
+        if(accelerationIndex < 0)
+        {
+            delta = -0.001;
+            accelerationIndex = accelerationIndices_.decrement[val];
+        }
         
-        else if(accelerationIndicesForDecrement_.count(val) > 0)
-            widget_->QueueRelativeAction(accelerationIndicesForDecrement_[val], -0.001);
+        if(accelerationIndex < 0)
+            return;
+        
+        if(velocityCurve_.GetIsEnabled())
+            accelerationIndex = velocityCurve_.GetAccelerationIndex(delta > 0, DAW::GetCurrentNumberOfMilliseconds());
+        
+        widget_->QueueRelativeAction(accelerationIndex, delta);
     }
 };
 
@@ -388,6 +455,8 @@ public:
     virtual ~TwoState_Midi_FeedbackProcessor() {}
     TwoState_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1, MIDI_event_ex_t* feedback2) : Midi_FeedbackProcessor(surface, widget, feedback1, feedback2) { }
     
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; }
+    
     virtual void SetValue(double value) override
     {
         if(value == 0.0)
@@ -428,6 +497,20 @@ public:
     virtual ~NovationLaunchpadMiniRGB7Bit_Midi_FeedbackProcessor() {}
     NovationLaunchpadMiniRGB7Bit_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
     
+    virtual int GetSupportedValueChannels() override { return RGBValueChannel; }
+    
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override
+    {
+        Midi_FeedbackProcessor::CopyCacheFrom(source);
+        
+        if(NovationLaunchpadMiniRGB7Bit_Midi_FeedbackProcessor* rgbSource = dynamic_cast<NovationLaunchpadMiniRGB7Bit_Midi_FeedbackProcessor*>(source))
+        {
+            lastR = rgbSource->lastR;
+            lastG = rgbSource->lastG;
+            lastB = rgbSource->lastB;
+        }
+    }
+    
     virtual void SetRGBValue(int r, int g, int b) override
     {
         if(r == lastR && g == lastG && b == lastB)
@@ -442,6 +525,28 @@ public:
         lastG = g;
         lastB = b;
         
+        Send7BitRGB(r / 2, g / 2, b / 2); // only 127 bit max for this device
+    }
+    
+    virtual void SetTrackColor(TrackColor &color) override
+    {
+        if(color.rgb.r == lastR && color.rgb.g == lastG && color.rgb.b == lastB)
+            return;
+        
+        ForceTrackColor(color);
+    }
+    
+    virtual void ForceTrackColor(TrackColor &color) override
+    {
+        lastR = color.rgb.r;
+        lastG = color.rgb.g;
+        lastB = color.rgb.b;
+        
+        Send7BitRGB(color.rgb7Bit.r, color.rgb7Bit.g, color.rgb7Bit.b);
+    }
+    
+    void Send7BitRGB(int r, int g, int b)
+    {
         struct
         {
             MIDI_event_ex_t evt;
@@ -460,9 +565,9 @@ public:
         
         midiSysExData.evt.midi_message[midiSysExData.evt.size++] = 0x03;
         midiSysExData.evt.midi_message[midiSysExData.evt.size++] = midiFeedbackMessage1_->midi_message[1] ;
-        midiSysExData.evt.midi_message[midiSysExData.evt.size++] = r / 2; // only 127 bit max for this device
-        midiSysExData.evt.midi_message[midiSysExData.evt.size++] = g / 2;
-        midiSysExData.evt.midi_message[midiSysExData.evt.size++] = b / 2;
+        midiSysExData.evt.midi_message[midiSysExData.evt.size++] = r;
+        midiSysExData.evt.midi_message[midiSysExData.evt.size++] = g;
+        midiSysExData.evt.midi_message[midiSysExData.evt.size++] = b;
         
         midiSysExData.evt.midi_message[midiSysExData.evt.size++] = 0xF7;
         
@@ -483,6 +588,20 @@ public:
     virtual ~FaderportRGB7Bit_Midi_FeedbackProcessor() {}
     FaderportRGB7Bit_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
     
+    virtual int GetSupportedValueChannels() override { return RGBValueChannel; }
+    
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override
+    {
+        Midi_FeedbackProcessor::CopyCacheFrom(source);
+        
+        if(FaderportRGB7Bit_Midi_FeedbackProcessor* rgbSource = dynamic_cast<FaderportRGB7Bit_Midi_FeedbackProcessor*>(source))
+        {
+            lastR_ = rgbSource->lastR_;
+            lastG_ = rgbSource->lastG_;
+            lastB_ = rgbSource->lastB_;
+        }
+    }
+    
     virtual void SetRGBValue(int r, int g, int b) override
     {
         if(r == lastR_ && g == lastG_ && b == lastB_)
@@ -497,73 +616,245 @@ public:
         lastG_ = g;
         lastB_ = b;
         
+        Send7BitRGB(r / 2, g / 2, b / 2);  // only 127 bit allowed in Midi byte 3
+    }
+    
+    virtual void SetTrackColor(TrackColor &color) override
+    {
+        if(color.rgb.r == lastR_ && color.rgb.g == lastG_ && color.rgb.b == lastB_)
+            return;
+        
+        ForceTrackColor(color);
+    }
+    
+    virtual void ForceTrackColor(TrackColor &color) override
+    {
+        lastR_ = color.rgb.r;
+        lastG_ = color.rgb.g;
+        lastB_ = color.rgb.b;
+        
+        Send7BitRGB(color.rgb7Bit.r, color.rgb7Bit.g, color.rgb7Bit.b);
+    }
+    
+    void Send7BitRGB(int r, int g, int b)
+    {
         SendMidiMessage(0x90, midiFeedbackMessage1_->midi_message[1], 0x7f);
-        SendMidiMessage(0x91, midiFeedbackMessage1_->midi_message[1], r / 2);  // only 127 bit allowed in Midi byte 3
-        SendMidiMessage(0x92, midiFeedbackMessage1_->midi_message[1], g / 2);
-        SendMidiMessage(0x93, midiFeedbackMessage1_->midi_message[1], b / 2);
+        SendMidiMessage(0x91, midiFeedbackMessage1_->midi_message[1], r);
+        SendMidiMessage(0x92, midiFeedbackMessage1_->midi_message[1], g);
+        SendMidiMessage(0x93, midiFeedbackMessage1_->midi_message[1], b);
     }
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-class Fader14Bit_Midi_FeedbackProcessor : public Midi_FeedbackProcessor
+class MotorFaderPositionFilter
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 {
+    // Decides when a motor fader position actually goes out -- moves inside the deadband, or sooner than the rate limit allows,
+    // are held back and sent once the fader has settled. Times are in ms and passed in, so this never asks REAPER for the clock.
+private:
+    int deadband_ = 0;
+    double minUpdateInterval_ = 0.0;
+    
+    int lastPositionSent_ = -1;
+    double lastSendTime_ = 0.0;
+    
+    bool hasPendingPosition_ = false;
+    int pendingPosition_ = 0;
+    double pendingSince_ = 0.0;
+    
 public:
-    virtual ~Fader14Bit_Midi_FeedbackProcessor() {}
-    Fader14Bit_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
+    MotorFaderPositionFilter(int deadband, int maxUpdateRate) : deadband_(deadband)
+    {
+        SetMaxUpdateRate(maxUpdateRate);
+    }
     
-    virtual void SetValue(double value) override
+    void SetDeadband(int deadband) { deadband_ = deadband; }
+    void SetMaxUpdateRate(int updatesPerSecond) { minUpdateInterval_ = updatesPerSecond > 0 ? 1000.0 / updatesPerSecond : 0.0; }
+    
+    bool GetHasPendingPosition() { return hasPendingPosition_; }
+    bool GetIsSent(int position) { return position == lastPositionSent_; }
+    
+    void Reset()
     {
-        int volint = value * 16383.0;
-        SendMidiMessage(midiFeedbackMessage1_->midi_message[0], volint&0x7f, (volint>>7)&0x7f);
+        lastPositionSent_ = -1;
+        hasPendingPosition_ = false;
     }
     
-    virtual void ForceValue(double value) override
+    void CopyFrom(const MotorFaderPositionFilter &source)
     {
-        int volint = value * 16383.0;
-        ForceMidiMessage(midiFeedbackMessage1_->midi_message[0], volint&0x7f, (volint>>7)&0x7f);
+        // A position the source was still holding back never reached the fader
+        lastPositionSent_ = source.hasPendingPosition_ ? -1 : source.lastPositionSent_;
+        hasPendingPosition_ = false;
     }
     
-    virtual void SetValue(int displayMode, double value) override
+    void SetSent(int position, double now)
     {
-        SetValue(value);
+        lastPositionSent_ = position;
+        lastSendTime_ = now;
+        hasPendingPosition_ = false;
     }
     
-    virtual void ForceValue(int displayMode, double value) override
+    // true if position should be sent now, otherwise it is held until TakePendingPosition lets it through
+    bool SetPosition(int position, double now)
     {
-        ForceValue(value);
+        if(GetIsSent(position))
+        {
+            hasPendingPosition_ = false;
+            return false;
+        }
+        
+        if( ! hasPendingPosition_ || position != pendingPosition_)
+        {
+            hasPendingPosition_ = true;
+            pendingPosition_ = position;
+            pendingSince_ = now;
+        }
+        
+        int positionToSend = 0;
+        
+        return TakePendingPosition(now, positionToSend);
+    }
+    
+    // true, with the position to send, once the held position is far enough away, the rate limit allows it, or it has settled
+    bool TakePendingPosition(double now, int &position)
+    {
+        if( ! hasPendingPosition_ || now - lastSendTime_ < minUpdateInterval_)
+            return false;
+        
+        if(lastPositionSent_ < 0 || abs(pendingPosition_ - lastPositionSent_) > deadband_ || now - pendingSince_ >= FaderSettleTime)
+        {
+            position = pendingPosition_;
+            SetSent(position, now);
+            return true;
+        }
+        
+        return false;
     }
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-class Fader7Bit_Midi_FeedbackProcessor : public Midi_FeedbackProcessor
+class MotorFader_Midi_FeedbackProcessor : public Midi_FeedbackProcessor
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 {
+    // Automation moves the parameter a little every tick, sending each step makes motor faders buzz and floods the port.
+    // MotorFaderPositionFilter decides which positions go out, this only turns values into positions and sends them.
+    // The filter is off unless the .mst line turns it on, with no deadband or rate limit every new position goes straight out.
+private:
+    MotorFaderPositionFilter positionFilter_;
+
+protected:
+    MotorFader_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1), positionFilter_(FaderDeadband, FaderMaxUpdateRate) {}
+    
+    virtual int GetFaderPosition(double value) = 0;
+    virtual void ForceFaderPosition(int position) = 0;
+    
 public:
-    virtual ~Fader7Bit_Midi_FeedbackProcessor() {}
-    Fader7Bit_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
+    virtual ~MotorFader_Midi_FeedbackProcessor() {}
+    
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; } // the param form sends the same message
+    
+    void SetDeadband(int deadband) { positionFilter_.SetDeadband(deadband); }
+    void SetMaxUpdateRate(int updatesPerSecond) { positionFilter_.SetMaxUpdateRate(updatesPerSecond); }
+    
+    virtual void ClearCache() override
+    {
+        Midi_FeedbackProcessor::ClearCache();
+        
+        positionFilter_.Reset();
+    }
+    
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override
+    {
+        Midi_FeedbackProcessor::CopyCacheFrom(source);
+        
+        if(MotorFader_Midi_FeedbackProcessor* faderSource = dynamic_cast<MotorFader_Midi_FeedbackProcessor*>(source))
+            positionFilter_.CopyFrom(faderSource->positionFilter_);
+        else
+            positionFilter_.Reset();
+    }
+    
+    virtual void RunDeferredFeedback() override
+    {
+        int position = 0;
+        
+        if(positionFilter_.GetHasPendingPosition() && positionFilter_.TakePendingPosition(DAW::GetCurrentNumberOfMilliseconds(), position))
+            ForceFaderPosition(position);
+    }
     
     virtual void SetValue(double value) override
     {
-        SendMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], value * 127.0);
+        int position = GetFaderPosition(value);
+        
+        if(positionFilter_.GetIsSent(position) && ! positionFilter_.GetHasPendingPosition())
+            return;
+        
+        if(positionFilter_.SetPosition(position, DAW::GetCurrentNumberOfMilliseconds()))
+            ForceFaderPosition(position);
     }
     
     virtual void ForceValue(double value) override
     {
-        ForceMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], value * 127.0);
+        int position = GetFaderPosition(value);
+        
+        positionFilter_.SetSent(position, DAW::GetCurrentNumberOfMilliseconds());
+        ForceFaderPosition(position);
     }
     
     virtual void SetValue(int displayMode, double value) override
     {
         SetValue(value);
     }
-
+    
     virtual void ForceValue(int displayMode, double value) override
     {
         ForceValue(value);
     }
 };
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class Fader14Bit_Midi_FeedbackProcessor : public MotorFader_Midi_FeedbackProcessor
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+protected:
+    virtual int GetFaderPosition(double value) override
+    {
+        return value * 16383.0;
+    }
+    
+    virtual void ForceFaderPosition(int position) override
+    {
+        ForceMidiMessage(midiFeedbackMessage1_->midi_message[0], position&0x7f, (position>>7)&0x7f);
+    }
+    
+public:
+    virtual ~Fader14Bit_Midi_FeedbackProcessor() {}
+    Fader14Bit_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : MotorFader_Midi_FeedbackProcessor(surface, widget, feedback1) { }
+    
+    virtual double GetFeedbackEpsilon() override { return 0.25 / 16383.0; } // a quarter of a step
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class Fader7Bit_Midi_FeedbackProcessor : public MotorFader_Midi_FeedbackProcessor
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+protected:
+    virtual int GetFaderPosition(double value) override
+    {
+        return value * 127.0;
+    }
+    
+    virtual void ForceFaderPosition(int position) override
+    {
+        ForceMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], position);
+    }
+    
+public:
+    virtual ~Fader7Bit_Midi_FeedbackProcessor() {}
+    Fader7Bit_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : MotorFader_Midi_FeedbackProcessor(surface, widget, feedback1) { }
+    
+    virtual double GetFeedbackEpsilon() override { return 0.25 / 127.0; } // a quarter of a step
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class Encoder_Midi_FeedbackProcessor : public Midi_FeedbackProcessor
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -572,6 +863,10 @@ public:
     virtual ~Encoder_Midi_FeedbackProcessor() {}
     Encoder_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
     
+    virtual double GetFeedbackEpsilon() override { return 0.25 / 127.0; } // a quarter of a step, the ring itself only has 11 LEDs
+    
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; } // the param form sends the same message
+    
     virtual void SetValue(double value) override
     {
         SetValue(0, value);
@@ -613,6 +908,8 @@ public:
     virtual ~VUMeter_Midi_FeedbackProcessor() {}
     VUMeter_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
     
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; }
+    
     virtual void SetValue(double value) override
     {
         SendMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], GetMidiValue(value));
@@ -650,6 +947,8 @@ public:
     virtual ~GainReductionMeter_Midi_FeedbackProcessor() {}
     GainReductionMeter_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
     
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; }
+    
     virtual void SetValue(double value) override
     {
         SendMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], fabs(1.0 - value) * 127.0);
@@ -674,6 +973,8 @@ public:
     virtual ~QConProXMasterVUMeter_Midi_FeedbackProcessor() {}
     QConProXMasterVUMeter_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, int param) : Midi_FeedbackProcessor(surface, widget), param_(param) { }
     
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; }
+    
     virtual void SetValue(double value) override
     {
         //Master Channel:
@@ -723,6 +1024,8 @@ public:
     virtual ~MCUVUMeter_Midi_FeedbackProcessor() {}
     MCUVUMeter_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, int displayType, int channelNumber) : Midi_FeedbackProcessor(surface, widget), displayType_(displayType), channelNumber_(channelNumber) {}
     
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; }
+    
     virtual void SetValue(double value) override
     {
         SendMidiMessage(0xd0, (channelNumber_ << 4) | GetMidiValue(value), 0);
@@ -753,33 +1056,43 @@ private:
     int displayType_ = 0x10;
     int displayRow_ = 0x12;
     int channel_ = 0;
-    string lastStringSent_ = "";
+    DisplayString lastStringSent_;
 
 public:
     virtual ~MCUDisplay_Midi_FeedbackProcessor() {}
     MCUDisplay_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, int displayUpperLower, int displayType, int displayRow, int channel) : Midi_FeedbackProcessor(surface, widget), offset_(displayUpperLower * 56), displayType_(displayType), displayRow_(displayRow), channel_(channel) { }
     
+    virtual int GetSupportedValueChannels() override { return StringValueChannel; }
+    
     virtual void ClearCache() override
     {
         lastStringSent_ = " ";
     }
     
-    virtual void SetValue(string displayText) override
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override
+    {
+        Midi_FeedbackProcessor::CopyCacheFrom(source);
+        
+        if(MCUDisplay_Midi_FeedbackProcessor* displaySource = dynamic_cast<MCUDisplay_Midi_FeedbackProcessor*>(source))
+            lastStringSent_ = displaySource->lastStringSent_;
+    }
+    
+    virtual void SetValue(const string &displayText) override
     {
         if(displayText != lastStringSent_) // changes since last send
             ForceValue(displayText);
     }
 
-    virtual void ForceValue(string displayText) override
+    virtual void ForceValue(const string &displayText) override
     {
         lastStringSent_ = displayText;
         
-        if(displayText == "" || displayText == "-150.00")
-            displayText = "       ";
-
         int pad = 7;
         const char* text = displayText.c_str();
         
+        if(displayText == "" || displayText == "-150.00")
+            text = "       ";
+        
         struct
         {
             MIDI_event_ex_t evt;
@@ -1086,13 +1399,13 @@ public:
         lastStringValue_ = " ";
     }
     
-    virtual void SetValue(string displayText) override
+    virtual void SetValue(const string &displayText) override
     {
         if(displayText != lastStringValue_) // changes since last send
             ForceValue(displayText);
     }
 
-    virtual void ForceValue(string value) override
+    virtual void ForceValue(const string &value) override
     {
         lastStringValue_ = value;
         text_ = value;
@@ -1311,13 +1624,13 @@ public:
         SetCurrentColor(value); // This will cause a Force()
     }
     
-    virtual void SetValue(string value) override
+    virtual void SetValue(const string &value) override
     {
         if(value != lastStringValue_) // changes since last send
             ForceValue(value);
     }
     
-    void ForceValue(string value) override
+    void ForceValue(const string &value) override
     {
         lastStringValue_ = value;
         text_ = value;
@@ -1505,31 +1818,41 @@ private:
     int displayType_ = 0x02;
     int displayRow_ = 0x00;
     int channel_ = 0;
-    string lastStringSent_ = " ";
+    DisplayString lastStringSent_ = " ";
     
 public:
     virtual ~FPDisplay_Midi_FeedbackProcessor() {}
     FPDisplay_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, int displayType, int channel, int displayRow) : Midi_FeedbackProcessor(surface, widget), displayType_(displayType), channel_(channel), displayRow_(displayRow) { }
     
+    virtual int GetSupportedValueChannels() override { return StringValueChannel; }
+    
     virtual void ClearCache() override
     {
         lastStringSent_ = " ";
     }
     
-    virtual void SetValue(string displayText) override
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override
+    {
+        Midi_FeedbackProcessor::CopyCacheFrom(source);
+        
+        if(FPDisplay_Midi_FeedbackProcessor* displaySource = dynamic_cast<FPDisplay_Midi_FeedbackProcessor*>(source))
+            lastStringSent_ = displaySource->lastStringSent_;
+    }
+    
+    virtual void SetValue(const string &displayText) override
     {
         if(displayText != lastStringSent_) // changes since last send
             ForceValue(displayText);
     }
     
-    virtual void ForceValue(string displayText) override
+    virtual void ForceValue(const string &displayText) override
     {
         lastStringSent_ = displayText;
 
-        if(displayText == "")
-            displayText = "                            ";
-        
         const char* text = displayText.c_str();
+        
+        if(displayText == "")
+            text = "                            ";
     
         struct
         {
@@ -1580,33 +1903,43 @@ private:
     int displayType_ = 0x14;
     int displayRow_ = 0x12;
     int channel_ = 0;
-    string lastStringSent_ = "";
+    DisplayString lastStringSent_;
     
 public:
     virtual ~QConLiteDisplay_Midi_FeedbackProcessor() {}
     QConLiteDisplay_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, int displayUpperLower, int displayType, int displayRow, int channel) : Midi_FeedbackProcessor(surface, widget), offset_(displayUpperLower * 28), displayType_(displayType), displayRow_(displayRow), channel_(channel) { }
     
+    virtual int GetSupportedValueChannels() override { return StringValueChannel; }
+    
     virtual void ClearCache() override
     {
         lastStringSent_ = " ";
     }
     
-    virtual void SetValue(string displayText) override
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override
+    {
+        Midi_FeedbackProcessor::CopyCacheFrom(source);
+        
+        if(QConLiteDisplay_Midi_FeedbackProcessor* displaySource = dynamic_cast<QConLiteDisplay_Midi_FeedbackProcessor*>(source))
+            lastStringSent_ = displaySource->lastStringSent_;
+    }
+    
+    virtual void SetValue(const string &displayText) override
     {
         if(displayText != lastStringSent_) // changes since last send
             ForceValue(displayText);
     }
     
-    virtual void ForceValue(string displayText) override
+    virtual void ForceValue(const string &displayText) override
     {
         lastStringSent_ = displayText;
         
-        if(displayText == "")
-            displayText = "       ";
-        
         int pad = 7;
         const char* text = displayText.c_str();
         
+        if(displayText == "")
+            text = "       ";
+        
         struct
         {
             MIDI_event_ex_t evt;
@@ -1645,9 +1978,9 @@ public:
     }
 };
 
-char m_mackie_lasttime[10];
-int m_mackie_lasttime_mode;
-DWORD m_mcu_timedisp_lastforce, m_mcu_meter_lastrun;
+static char m_mackie_lasttime[10];
+static int m_mackie_lasttime_mode;
+static DWORD m_mcu_timedisp_lastforce, m_mcu_meter_lastrun;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class MCU_TimeDisplay_Midi_FeedbackProcessor : public Midi_FeedbackProcessor
@@ -1656,6 +1989,8 @@ class MCU_TimeDisplay_Midi_FeedbackProcessor : public Midi_FeedbackProcessor
 public:
     MCU_TimeDisplay_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget) : Midi_FeedbackProcessor(surface, widget) {}
     
+    virtual int GetSupportedValueChannels() override { return DoubleValueChannel; }
+    
     virtual void SetValue(double value) override
     {
         
@@ -1812,7 +2147,7 @@ public:
 
 
 // Color maps are stored in Blue Green Red format
-uint8_t colorMap7[128][3] = { {0, 0, 0},    // 0
+static uint8_t colorMap7[128][3] = { {0, 0, 0},    // 0
     {255, 0, 0},    // 1 - Blue
     {255, 21, 0},    // 2 - Blue (Green Rising)
     {255, 34, 0},
@@ -1947,7 +2282,7 @@ uint8_t colorMap7[128][3] = { {0, 0, 0},    // 0
     {225, 240, 240}    // 127 - White ?
 };
 
-int GetColorIntFromRGB(int r, int g, int b)
+static int GetColorIntFromRGB(int r, int g, int b)
 {
     if(b == 0 && g == 0 && r == 0)
         return 0;
@@ -2002,10 +2337,47 @@ private:
     int lastG = 0;
     int lastB = 0;
     
+    // Fixed colours from the zone file -- the palette search runs once per colour this encoder shows, an encoder only ever cycles through a few of them.
+    // Track colours carry their palette entry in TrackColor instead.
+    static const int MaxCachedColors = 16;
+    map<int, int> colorInts_;
+    
+    int GetCachedColorIntFromRGB(int r, int g, int b)
+    {
+        int packedRGB = (r << 16) | (g << 8) | b;
+        
+        auto it = colorInts_.find(packedRGB);
+        
+        if(it != colorInts_.end())
+            return it->second;
+        
+        if(colorInts_.size() >= MaxCachedColors)
+            colorInts_.clear();
+        
+        int colorInt = GetColorIntFromRGB(r, g, b);
+        colorInts_[packedRGB] = colorInt;
+        
+        return colorInt;
+    }
+    
 public:
     virtual ~MFT_RGB_Midi_FeedbackProcessor() {}
     MFT_RGB_Midi_FeedbackProcessor(Midi_ControlSurface* surface, Widget* widget, MIDI_event_ex_t* feedback1) : Midi_FeedbackProcessor(surface, widget, feedback1) { }
     
+    virtual int GetSupportedValueChannels() override { return RGBValueChannel; }
+    
+    virtual void CopyCacheFrom(FeedbackProcessor* source) override
+    {
+        Midi_FeedbackProcessor::CopyCacheFrom(source);
+        
+        if(MFT_RGB_Midi_FeedbackProcessor* rgbSource = dynamic_cast<MFT_RGB_Midi_FeedbackProcessor*>(source))
+        {
+            lastR = rgbSource->lastR;
+            lastG = rgbSource->lastG;
+            lastB = rgbSource->lastB;
+        }
+    }
+    
     virtual void ForceRGBValue(int r, int g, int b) override
     {
         lastR = r;
@@ -2015,7 +2387,7 @@ public:
         if((r == 177 || r == 181) && g == 31) // this sets the different MFT modes
             SendMidiMessage(r, g, b);
         else
-            SendMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], GetColorIntFromRGB(r, g, b));
+            SendMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], GetCachedColorIntFromRGB(r, g, b));
     }
 
     virtual void SetRGBValue(int r, int g, int b) override
@@ -2025,6 +2397,32 @@ public:
         
         ForceRGBValue(r, g, b);
     }
+    
+    virtual void SetTrackColor(TrackColor &color) override
+    {
+        if(color.rgb.r == lastR && color.rgb.g == lastG && color.rgb.b == lastB)
+            return;
+        
+        ForceTrackColor(color);
+    }
+    
+    virtual void ForceTrackColor(TrackColor &color) override
+    {
+        if((color.rgb.r == 177 || color.rgb.r == 181) && color.rgb.g == 31) // reads as a mode change, same as a fixed colour would
+        {
+            ForceRGBValue(color.rgb.r, color.rgb.g, color.rgb.b);
+            return;
+        }
+        
+        if(color.mftColorIndex < 0) // the other encoders showing this track reuse it
+            color.mftColorIndex = GetColorIntFromRGB(color.rgb.r, color.rgb.g, color.rgb.b);
+        
+        lastR = color.rgb.r;
+        lastG = color.rgb.g;
+        lastB = color.rgb.b;
+        
+        SendMidiMessage(midiFeedbackMessage1_->midi_message[0], midiFeedbackMessage1_->midi_message[1], color.mftColorIndex);
+    }
 };
 
 #endif /* control_surface_midi_widgets_h */
@@ -2143,13 +2541,13 @@ public:
         lastStringValue_ = " ";
     }
     
-    virtual void SetValue(string displayText) override
+    virtual void SetValue(const string &displayText) override
     {
         if(displayText != lastStringValue_) // changes since last send
             ForceValue(displayText);
     }
     
-    virtual void ForceValue(string value) override
+    virtual void ForceValue(const string &value) override
     {
         lastStringValue_ = value;
         text_ = value;
@@ -2404,13 +2802,13 @@ public:
         SetCurrentColor(value); // This will cause a Force()
     }
     
-    virtual void SetValue(string value) override
+    virtual void SetValue(const string &value) override
     {
         if(value != lastStringValue_) // changes since last send
             ForceValue(value);
     }
     
-    void ForceValue(string value) override
+    void ForceValue(const string &value) override
     {
         lastStringValue_ = value;
         text_ = value;
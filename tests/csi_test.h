@@ -0,0 +1,69 @@
+//
+//  csi_test.h
+//  reaper_csurf_integrator tests
+//
+//  Just enough of a harness to run the plain logic -- parsing, value lookup, encoder and fader feedback -- outside REAPER.
+//  Benchmarks are registered the same way and only run with "csi_tests bench"
+//
+
+#ifndef csi_test_h
+#define csi_test_h
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TestCase
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    const char* name;
+    void (*function)();
+};
+
+std::vector<TestCase> &GetTestCases();
+std::vector<TestCase> &GetBenchmarks();
+extern int g_testFailures;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TestRegistrar
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    TestRegistrar(std::vector<TestCase> &testCases, const char* name, void (*function)()) { testCases.push_back({ name, function }); }
+};
+
+#define TEST(name) \
+    static void name(); \
+    static TestRegistrar name##_registrar(GetTestCases(), #name, name); \
+    static void name()
+
+#define BENCHMARK(name) \
+    static void name(); \
+    static TestRegistrar name##_registrar(GetBenchmarks(), #name, name); \
+    static void name()
+
+// Average time of one call to function, in microseconds
+template<typename Function> double GetMicrosecondsPerRun(int numRuns, Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    
+    for(int i = 0; i < numRuns; i++)
+        function();
+    
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / numRuns;
+}
+
+#define CHECK(condition) \
+    do { \
+        if( ! (condition)) \
+        { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            g_testFailures++; \
+        } \
+    } while(0)
+
+#define CHECK_EQUAL(expected, actual) CHECK((expected) == (actual))
+#define CHECK_CLOSE(expected, actual) CHECK(fabs((expected) - (actual)) < 0.000001)
+
+#endif /* csi_test_h */
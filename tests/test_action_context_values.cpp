@@ -0,0 +1,162 @@
+//
+//  test_action_context_values.cpp
+//  reaper_csurf_integrator tests
+//
+//  The values an ActionContext takes from its zone file line, and the stepped value lookup built from them
+//
+
+#include "control_surface_integrator.h"
+
+#include "csi_test.h"
+
+TEST(ActionContextValuesReadsTheLine)
+{
+    shared_ptr<const ActionContextValues> values = ActionContextValues::Build({ "TrackVolume", "[", "0.2>0.8", "(0.05)", "(1,2,4)", "]" }, { { "NoFeedback" }, { "SoftTakeover", "0.1" } });
+    
+    CHECK(values->hasRange);
+    CHECK_CLOSE(0.2, values->rangeMinimum);
+    CHECK_CLOSE(0.8, values->rangeMaximum);
+    CHECK_CLOSE(0.05, values->deltaValue);
+    CHECK_EQUAL(3, (int)values->acceleratedTickValues.size());
+    CHECK_EQUAL(4, values->acceleratedTickValues[2]);
+    CHECK(values->noFeedback);
+    CHECK(values->isSoftTakeover);
+    CHECK_CLOSE(0.1, values->softTakeoverWindow);
+    CHECK_EQUAL(2, (int)values->properties.size());
+}
+
+TEST(ActionContextValuesDefaults)
+{
+    shared_ptr<const ActionContextValues> values = ActionContextValues::Build({ "TrackVolume" }, {});
+    
+    CHECK( ! values->hasRange);
+    CHECK( ! values->noFeedback);
+    CHECK( ! values->isSoftTakeover);
+    CHECK_EQUAL(0, (int)values->steppedValues.size());
+    CHECK_EQUAL(1, (int)values->acceleratedTickValues.size());
+    CHECK_EQUAL(10, values->acceleratedTickValues[0]);
+    
+    values = ActionContextValues::Build({ "SoftTakeover14BitTrackVolume" }, {});
+    
+    CHECK(values->isSoftTakeover);
+    CHECK_CLOSE(0.0025, values->softTakeoverWindow);
+}
+
+TEST(SteppedValueIndexFindsClosestStep)
+{
+    shared_ptr<const ActionContextValues> values = ActionContextValues::Build({ "TrackPan", "[", "0.0", "0.5", "1.0", "]" }, {});
+    
+    CHECK_EQUAL(2, (int)values->steppedValueBinBoundaries.size());
+    CHECK_EQUAL(0, values->GetSteppedValueIndex(-1.0));
+    CHECK_EQUAL(0, values->GetSteppedValueIndex(0.2));
+    CHECK_EQUAL(1, values->GetSteppedValueIndex(0.3));
+    CHECK_EQUAL(1, values->GetSteppedValueIndex(0.7));
+    CHECK_EQUAL(2, values->GetSteppedValueIndex(0.9));
+    CHECK_EQUAL(2, values->GetSteppedValueIndex(2.0));
+}
+
+TEST(SteppedValueIndexTieGoesToFirstListed)
+{
+    shared_ptr<const ActionContextValues> ascending = ActionContextValues::Build({ "TrackPan", "[", "0.0", "0.5", "1.0", "]" }, {});
+    
+    CHECK_EQUAL(0, ascending->GetSteppedValueIndex(0.25));
+    CHECK_EQUAL(1, ascending->GetSteppedValueIndex(0.75));
+    
+    shared_ptr<const ActionContextValues> descending = ActionContextValues::Build({ "TrackPan", "[", "1.0", "0.5", "0.0", "]" }, {});
+    
+    CHECK_EQUAL(0, descending->GetSteppedValueIndex(0.75));
+    CHECK_EQUAL(1, descending->GetSteppedValueIndex(0.25));
+    CHECK_EQUAL(2, descending->GetSteppedValueIndex(0.1));
+    
+    // Enough steps for the bin search rather than the scan
+    shared_ptr<const ActionContextValues> binned = ActionContextValues::Build({ "TrackPan", "[", "1.0", "0.75", "0.5", "0.25", "0.0", "]" }, {});
+    
+    CHECK((int)binned->steppedValues.size() >= ActionContextValues::MaxScannedSteps);
+    CHECK_EQUAL(0, binned->GetSteppedValueIndex(0.875));
+    CHECK_EQUAL(1, binned->GetSteppedValueIndex(0.625));
+    CHECK_EQUAL(3, binned->GetSteppedValueIndex(0.125));
+    CHECK_EQUAL(4, binned->GetSteppedValueIndex(0.1));
+}
+
+TEST(SteppedValueIndexSkipsRepeatedSteps)
+{
+    shared_ptr<const ActionContextValues> values = ActionContextValues::Build({ "TrackPan", "[", "0.0", "0.5", "0.5", "1.0", "]" }, {});
+    
+    CHECK_EQUAL(4, (int)values->steppedValues.size());
+    CHECK_EQUAL(2, (int)values->steppedValueBinBoundaries.size());
+    CHECK_EQUAL(1, values->GetSteppedValueIndex(0.5));
+    CHECK_EQUAL(1, values->GetSteppedValueIndex(0.6));
+    CHECK_EQUAL(3, values->GetSteppedValueIndex(0.8));
+    
+    shared_ptr<const ActionContextValues> single = ActionContextValues::Build({ "TrackPan", "[", "0.5", "]" }, {});
+    
+    CHECK_EQUAL(0, single->GetSteppedValueIndex(0.0));
+    CHECK_EQUAL(0, single->GetSteppedValueIndex(1.0));
+}
+
+// The lookup SetSteppedValueIndex did before the bins, kept here to time against
+static int GetSteppedValueIndexByLinearScan(const vector<double> &steppedValues, double value)
+{
+    int index = 0;
+    double delta = 100000000.0;
+    
+    for(int i = 0; i < (int)steppedValues.size(); i++)
+        if(fabs(steppedValues[i] - value) < delta)
+        {
+            delta = fabs(steppedValues[i] - value);
+            index = i;
+        }
+    
+    return index;
+}
+
+TEST(SteppedValueIndexMatchesLinearScan)
+{
+    for(int numSteps : { 2, 3, 8, 128 })
+    {
+        vector<string> params = { "TrackPan", "[" };
+        
+        for(int i = 0; i < numSteps; i++)
+            params.push_back(to_string((i * 7 % numSteps) / double(numSteps - 1))); // not in order
+        
+        params.push_back("]");
+        
+        shared_ptr<const ActionContextValues> values = ActionContextValues::Build(params, {});
+        
+        for(int i = 0; i <= 1000; i++)
+            CHECK_EQUAL(GetSteppedValueIndexByLinearScan(values->steppedValues, i / 1000.0), values->GetSteppedValueIndex(i / 1000.0));
+    }
+}
+
+BENCHMARK(SteppedValueIndexVersusLinearScan)
+{
+    const int numLookups = 1000;
+    
+    for(int numSteps : { 2, 8, 128 })
+    {
+        vector<string> params = { "TrackPan", "[" };
+        
+        for(int i = 0; i < numSteps; i++)
+            params.push_back(to_string(i / double(numSteps - 1)));
+        
+        params.push_back("]");
+        
+        shared_ptr<const ActionContextValues> values = ActionContextValues::Build(params, {});
+        
+        volatile int sink = 0;
+        
+        double linear = GetMicrosecondsPerRun(1000, [&]()
+        {
+            for(int i = 0; i < numLookups; i++)
+                sink = sink + GetSteppedValueIndexByLinearScan(values->steppedValues, i / double(numLookups));
+        });
+        
+        double binned = GetMicrosecondsPerRun(1000, [&]()
+        {
+            for(int i = 0; i < numLookups; i++)
+                sink = sink + values->GetSteppedValueIndex(i / double(numLookups));
+        });
+        
+        printf("    %3d steps, ns per lookup: linear scan %.1f, GetSteppedValueIndex %.1f\n", numSteps, linear * 1000.0 / numLookups, binned * 1000.0 / numLookups);
+    }
+}
@@ -0,0 +1,49 @@
+//
+//  test_encoders.cpp
+//  reaper_csurf_integrator tests
+//
+//  Encoder acceleration from the CC value lookup tables and the optional velocity curve
+//
+
+#include "control_surface_midi_widgets.h"
+
+#include "csi_test.h"
+
+TEST(EncoderAccelerationTableMapsValues)
+{
+    EncoderAccelerationTable table;
+    
+    EncoderAccelerationTable::SetIndices(table.increment, { 1, 2, 3, 200, -1 });
+    EncoderAccelerationTable::SetIndices(table.decrement, { 65, 66 });
+    
+    CHECK_EQUAL(0, table.increment[1]);
+    CHECK_EQUAL(1, table.increment[2]);
+    CHECK_EQUAL(2, table.increment[3]);
+    CHECK_EQUAL(-1, table.increment[0]);
+    CHECK_EQUAL(-1, table.increment[127]);
+    CHECK_EQUAL(0, table.decrement[65]);
+    CHECK_EQUAL(1, table.decrement[66]);
+    CHECK_EQUAL(-1, table.decrement[1]);
+}
+
+TEST(EncoderVelocityCurveNeedsThresholds)
+{
+    CHECK( ! EncoderVelocityCurve({ "Encoder", "[", "<", "1", "2", ">", "]" }).GetIsEnabled());
+    CHECK( ! EncoderVelocityCurve({ "Encoder", "Velocity" }).GetIsEnabled());
+    CHECK( ! EncoderVelocityCurve({ "Encoder", "Velocity", "fast" }).GetIsEnabled());
+    CHECK(EncoderVelocityCurve({ "Encoder", "Velocity", "120", "80.5" }).GetIsEnabled());
+}
+
+TEST(EncoderVelocityCurvePicksIndexFromInterval)
+{
+    EncoderVelocityCurve curve({ "Encoder", "Velocity", "120", "80", "50", "30" });
+    
+    CHECK_EQUAL(0, curve.GetAccelerationIndex(true, 1000.0)); // first detent, slow
+    CHECK_EQUAL(1, curve.GetAccelerationIndex(true, 1100.0)); // 100 ms
+    CHECK_EQUAL(3, curve.GetAccelerationIndex(true, 1140.0)); // 40 ms
+    CHECK_EQUAL(3, curve.GetAccelerationIndex(true, 1140.0)); // same batch keeps the speed
+    CHECK_EQUAL(4, curve.GetAccelerationIndex(true, 1160.0)); // 20 ms
+    CHECK_EQUAL(0, curve.GetAccelerationIndex(false, 1170.0)); // change of direction
+    CHECK_EQUAL(4, curve.GetAccelerationIndex(false, 1180.0));
+    CHECK_EQUAL(0, curve.GetAccelerationIndex(false, 5000.0));
+}
@@ -0,0 +1,59 @@
+//
+//  test_main.cpp
+//  reaper_csurf_integrator tests
+//
+//  Stands in for main.cpp -- the REAPER API pointers are left null, so tests must stick to code that never calls into REAPER
+//
+
+#include "csi_test.h"
+
+#include <string>
+
+#define REAPERAPI_IMPLEMENT
+#include "reaper_plugin_functions.h"
+
+class Manager;
+Manager* TheManager = nullptr;
+HWND g_hwnd;
+reaper_plugin_info_t *g_reaper_plugin_info;
+
+int g_testFailures = 0;
+
+std::vector<TestCase> &GetTestCases()
+{
+    static std::vector<TestCase> testCases;
+    return testCases;
+}
+
+std::vector<TestCase> &GetBenchmarks()
+{
+    static std::vector<TestCase> benchmarks;
+    return benchmarks;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc > 1 && std::string(argv[1]) == "bench")
+    {
+        for(auto &benchmark : GetBenchmarks())
+        {
+            printf("%s\n", benchmark.name);
+            benchmark.function();
+        }
+        
+        return 0;
+    }
+    
+    for(auto &testCase : GetTestCases())
+    {
+        int failures = g_testFailures;
+        
+        testCase.function();
+        
+        printf("%s %s\n", g_testFailures == failures ? "ok    " : "FAILED", testCase.name);
+    }
+    
+    printf("%d tests, %d failed checks\n", (int)GetTestCases().size(), g_testFailures);
+    
+    return g_testFailures == 0 ? 0 : 1;
+}
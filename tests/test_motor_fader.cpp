@@ -0,0 +1,106 @@
+//
+//  test_motor_fader.cpp
+//  reaper_csurf_integrator tests
+//
+//  Motor fader feedback filtering, all times are passed in so nothing here reads REAPER's clock
+//
+
+#include "control_surface_midi_widgets.h"
+
+#include "csi_test.h"
+
+TEST(MotorFaderFilterOffByDefault)
+{
+    MotorFaderPositionFilter filter(FaderDeadband, FaderMaxUpdateRate);
+    
+    CHECK(filter.SetPosition(100, 1000.0));
+    CHECK(filter.SetPosition(101, 1000.0)); // every move goes out at once
+    CHECK(filter.SetPosition(100, 1001.0));
+    CHECK( ! filter.SetPosition(100, 1002.0));
+    CHECK( ! filter.GetHasPendingPosition());
+}
+
+TEST(MotorFaderFilterSendsFirstAndLargeMoves)
+{
+    MotorFaderPositionFilter filter(8, 30);
+    
+    CHECK(filter.SetPosition(100, 1000.0));
+    CHECK(filter.GetIsSent(100));
+    
+    CHECK( ! filter.SetPosition(200, 1010.0)); // rate limited
+    CHECK(filter.GetHasPendingPosition());
+    
+    int position = 0;
+    
+    CHECK( ! filter.TakePendingPosition(1020.0, position));
+    CHECK(filter.TakePendingPosition(1050.0, position));
+    CHECK_EQUAL(200, position);
+    CHECK( ! filter.GetHasPendingPosition());
+    
+    CHECK( ! filter.SetPosition(200, 1200.0)); // already there
+    CHECK( ! filter.GetHasPendingPosition());
+}
+
+TEST(MotorFaderFilterHoldsSmallMovesUntilSettled)
+{
+    MotorFaderPositionFilter filter(8, 30);
+    int position = 0;
+    
+    CHECK(filter.SetPosition(100, 1000.0));
+    
+    CHECK( ! filter.SetPosition(104, 1100.0));
+    CHECK( ! filter.TakePendingPosition(1150.0, position));
+    
+    CHECK( ! filter.SetPosition(106, 1150.0)); // still moving, settle time starts again
+    CHECK( ! filter.TakePendingPosition(1220.0, position));
+    CHECK(filter.TakePendingPosition(1250.0, position));
+    CHECK_EQUAL(106, position);
+    
+    CHECK( ! filter.SetPosition(110, 1300.0));
+    CHECK( ! filter.SetPosition(106, 1310.0)); // back where the fader is, nothing left to send
+    CHECK( ! filter.GetHasPendingPosition());
+    CHECK( ! filter.TakePendingPosition(2000.0, position));
+}
+
+TEST(MotorFaderFilterRateLimit)
+{
+    MotorFaderPositionFilter filter(0, 0);
+    
+    CHECK(filter.SetPosition(100, 1000.0));
+    CHECK(filter.SetPosition(101, 1000.0)); // no limit, no deadband
+    
+    filter.SetMaxUpdateRate(10);
+    
+    CHECK( ! filter.SetPosition(102, 1050.0));
+    CHECK(filter.SetPosition(103, 1100.0));
+}
+
+TEST(MotorFaderFilterResetAndCopy)
+{
+    MotorFaderPositionFilter filter(8, 30);
+    
+    CHECK(filter.SetPosition(100, 1000.0));
+    
+    filter.Reset();
+    
+    CHECK( ! filter.GetIsSent(100));
+    CHECK(filter.SetPosition(100, 1050.0)); // after a reset the next position always goes out
+    
+    MotorFaderPositionFilter copy(8, 30);
+    
+    copy.CopyFrom(filter);
+    
+    CHECK(copy.GetIsSent(100));
+    
+    CHECK( ! filter.SetPosition(300, 1060.0));
+    
+    copy.CopyFrom(filter); // the source never sent 300, so the fader position is unknown
+    
+    CHECK( ! copy.GetIsSent(100));
+    CHECK( ! copy.GetHasPendingPosition());
+    CHECK(copy.SetPosition(100, 1070.0));
+    
+    copy.SetSent(500, 1080.0);
+    
+    CHECK(copy.GetIsSent(500));
+}
@@ -0,0 +1,220 @@
+//
+//  test_parsing.cpp
+//  reaper_csurf_integrator tests
+//
+//  Zone and surface file tokenising
+//
+
+#include "control_surface_integrator.h"
+
+#include "csi_test.h"
+
+TEST(GetTokensSplitsOnWhitespace)
+{
+    vector<string> tokens = GetTokens("  Widget\tFader1   Volume ");
+    
+    CHECK_EQUAL(3, (int)tokens.size());
+    CHECK(tokens[0] == "Widget");
+    CHECK(tokens[1] == "Fader1");
+    CHECK(tokens[2] == "Volume");
+}
+
+TEST(GetTokensKeepsQuotedText)
+{
+    vector<string> tokens = GetTokens("Display \"Track \\\"1\\\"\" Name");
+    
+    CHECK_EQUAL(3, (int)tokens.size());
+    CHECK(tokens[1] == "Track \"1\"");
+    CHECK(tokens[2] == "Name");
+    
+    tokens = GetTokens("Display \"\" Name");
+    
+    CHECK_EQUAL(3, (int)tokens.size());
+    CHECK(tokens[1] == "");
+}
+
+TEST(GetTokensStopsAtUnterminatedQuote)
+{
+    vector<string> tokens = GetTokens("Display \"Track Name");
+    
+    CHECK_EQUAL(1, (int)tokens.size());
+    CHECK(tokens[0] == "Display");
+}
+
+TEST(GetTokensIgnoresLineEndings)
+{
+    vector<string> tokens = GetTokens("Zone \"Ho\r\nme\"\r\n");
+    
+    CHECK_EQUAL(2, (int)tokens.size());
+    CHECK(tokens[1] == "Home");
+    CHECK_EQUAL(0, (int)GetTokens("\r\n").size());
+}
+
+TEST(LineReaderHandsOutEachLine)
+{
+    string text = "Zone Home\r\n\nZoneEnd";
+    LineReader reader(text);
+    string_view line;
+    
+    CHECK(reader.GetLine(line));
+    CHECK(line == "Zone Home\r");
+    CHECK(reader.GetLine(line));
+    CHECK(line == "");
+    CHECK(reader.GetLine(line));
+    CHECK(line == "ZoneEnd");
+    CHECK( ! reader.GetLine(line));
+}
+
+TEST(LineReaderHasNoLineAfterFinalNewline)
+{
+    string text = "ZoneEnd\n";
+    LineReader reader(text);
+    string_view line;
+    
+    CHECK(reader.GetLine(line));
+    CHECK(line == "ZoneEnd");
+    CHECK( ! reader.GetLine(line));
+    
+    string empty;
+    LineReader emptyReader(empty);
+    
+    CHECK( ! emptyReader.GetLine(line));
+}
+
+TEST(LineReaderGetZoneLineStripsComments)
+{
+    CHECK(LineReader::GetZoneLine("  Fader1  TrackVolume  // the volume\r") == "Fader1  TrackVolume");
+    CHECK(LineReader::GetZoneLine("Fader1 TrackVolume /\r/ split comment") == "Fader1 TrackVolume");
+    CHECK(LineReader::GetZoneLine("Fader1 TrackVolume / 2") == "Fader1 TrackVolume / 2");
+    CHECK(LineReader::GetZoneLine("   // comment only").size() == 0);
+    CHECK(LineReader::GetZoneLine("/ comment").size() == 0);
+    CHECK(LineReader::GetZoneLine(" \t\r").size() == 0);
+}
+
+TEST(LineReaderGetIsBlankOrComment)
+{
+    CHECK(LineReader::GetIsBlankOrComment(""));
+    CHECK(LineReader::GetIsBlankOrComment("\r"));
+    CHECK(LineReader::GetIsBlankOrComment("\r/ comment"));
+    CHECK( ! LineReader::GetIsBlankOrComment("Widget Fader1"));
+    CHECK( ! LineReader::GetIsBlankOrComment(" // indented"));
+}
+
+// What the zone and surface file readers did before LineReader and GetTokens, kept here to compare against
+static vector<string> GetRegexTokens(string line)
+{
+    vector<string> tokens;
+    
+    istringstream iss(line);
+    string token;
+    while (iss >> quoted(token))
+        tokens.push_back(token);
+    
+    return tokens;
+}
+
+static vector<string> GetRegexZoneTokens(string line)
+{
+    line = regex_replace(line, regex(TabChars), " ");
+    line = regex_replace(line, regex(CRLFChars), "");
+    
+    line = line.substr(0, line.find("//")); // remove trailing comments
+    
+    // Trim leading and trailing spaces
+    line = regex_replace(line, regex("^\\s+|\\s+$"), "", regex_constants::format_default);
+    
+    if(line == "" || (line.size() > 0 && line[0] == '/')) // ignore blank lines and comment lines
+        return vector<string>();
+    
+    return GetRegexTokens(line);
+}
+
+static vector<string> GetRegexSurfaceTokens(string line)
+{
+    line = regex_replace(line, regex(TabChars), " ");
+    line = regex_replace(line, regex(CRLFChars), "");
+    
+    if(line == "" || line[0] == '\r' || line[0] == '/') // ignore comment lines and blank lines
+        return vector<string>();
+    
+    return GetRegexTokens(line);
+}
+
+static vector<string> GetZoneTokens(string_view line)
+{
+    line = LineReader::GetZoneLine(line);
+    
+    if(line.size() == 0)
+        return vector<string>();
+    
+    return GetTokens(line);
+}
+
+static vector<string> GetSurfaceTokens(string_view line)
+{
+    if(LineReader::GetIsBlankOrComment(line))
+        return vector<string>();
+    
+    return GetTokens(line);
+}
+
+TEST(TokenizerMatchesRegexPath)
+{
+    // One line each, as getline hands them out -- no '\n', but a '\r' wherever a CRLF file leaves one
+    const vector<string> lines =
+    {
+        "",
+        "   ",
+        "\r",
+        "\t\r",
+        "Fader1 TrackVolume",
+        "\tFader1\t\tTrackVolume\r",
+        "  Shift+Fader1   TrackPan [ 0.0>1.0 (0.01) ]  ",
+        "Fader1 TrackVolume // the volume",
+        "Fader1 TrackVolume// no space",
+        "// a comment",
+        "   // an indented comment",
+        "/ a single slash",
+        "\r/ a slash after CR",
+        "Fader1 TrackVolume / 2",
+        "Fader1 TrackVolume /\r/ split by CR",
+        "Display \"Track Name\"",
+        "Display \"\"",
+        "Display \"\" Name",
+        "Display \"unterminated",
+        "Display \"unterminated with spaces  ",
+        "Display \"esc\\\"aped\" x",
+        "Display \"back\\\\slash\" x",
+        "Display \"ends in backslash\\",
+        "Display \"ends in escaped quote\\\"",
+        "Display \"tab\tinside\" x",
+        "Display \"two\t\ttabs\"",
+        "Display \"CR\rinside\" x",
+        "Display \"a // b\" x",
+        "Display \"http://x\"",
+        "Display \"a\"\"b\"",
+        "Display a\"b c\"",
+        "Display \"a\"b",
+        "Display\v\"vertical\"\ftab",
+        "Display \"Caf\xc3\xa9\" \xe2\x86\x92",
+        "Zone \"Home\" \"Alias Name\"\r",
+        "    IncludedZones",
+        "Fader|  TrackVolume",
+        "Hold+Press1 Reaper \"_S&M_CYCLACTION_1\"",
+    };
+    
+    for(auto &line : lines)
+    {
+        vector<string> zoneTokens = GetZoneTokens(line);
+        vector<string> surfaceTokens = GetSurfaceTokens(line);
+        
+        if(zoneTokens != GetRegexZoneTokens(line))
+            printf("    zone line differs: [%s]\n", line.c_str());
+        
+        if(surfaceTokens != GetRegexSurfaceTokens(line))
+            printf("    surface line differs: [%s]\n", line.c_str());
+        
+        CHECK(zoneTokens == GetRegexZoneTokens(line));
+        CHECK(surfaceTokens == GetRegexSurfaceTokens(line));
+    }
+}
@@ -0,0 +1,135 @@
+//
+//  test_soft_takeover.cpp
+//  reaper_csurf_integrator tests
+//
+//  Replays fader sweeps through SoftTakeover against a simulated parameter
+//
+
+#include "control_surface_integrator.h"
+
+#include "csi_test.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct SimulatedParameter
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // Stands in for the action -- the value only changes when the soft takeover lets the input through
+    double value = 0.0;
+    int appliedCount = 0;
+    
+    // Feeds the sweep in order, returns how many of its values were applied
+    int Replay(SoftTakeover &softTakeover, const vector<double> &sweep, double window = SoftTakeoverWindow)
+    {
+        int applied = appliedCount;
+        
+        for(auto input : sweep)
+        {
+            if(softTakeover.SetInput(input, value, window))
+            {
+                value = input;
+                appliedCount++;
+            }
+        }
+        
+        return appliedCount - applied;
+    }
+};
+
+TEST(SoftTakeoverIgnoresInputUntilCaught)
+{
+    SoftTakeover softTakeover;
+    SimulatedParameter parameter;
+    parameter.value = 0.5;
+    
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.0, 0.1, 0.2, 0.3 }));
+    CHECK_CLOSE(0.5, parameter.value);
+    CHECK( ! softTakeover.GetIsCaught());
+    CHECK_CLOSE(-0.2, softTakeover.GetOffset());
+    
+    CHECK_EQUAL(2, parameter.Replay(softTakeover, { 0.49, 0.6 }));
+    CHECK(softTakeover.GetIsCaught());
+    CHECK_CLOSE(0.0, softTakeover.GetOffset());
+    CHECK_CLOSE(0.6, parameter.value);
+}
+
+TEST(SoftTakeoverCatchesFastMoveThatOvershoots)
+{
+    SoftTakeover softTakeover;
+    SimulatedParameter parameter;
+    parameter.value = 0.5;
+    
+    // 0.3 to 0.8 in one message never lands in the window, but it crossed the parameter
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.1, 0.3 }));
+    CHECK_EQUAL(3, parameter.Replay(softTakeover, { 0.8, 0.9, 1.0 }));
+    CHECK_CLOSE(1.0, parameter.value);
+    
+    // Once caught it follows the fader back down, even in large steps
+    CHECK_EQUAL(2, parameter.Replay(softTakeover, { 0.6, 0.2 }));
+    CHECK_CLOSE(0.2, parameter.value);
+}
+
+TEST(SoftTakeoverLetsGoAfterBankChange)
+{
+    SoftTakeover softTakeover;
+    SimulatedParameter parameter;
+    parameter.value = 0.5;
+    
+    CHECK_EQUAL(2, parameter.Replay(softTakeover, { 0.5, 0.9 }));
+    
+    parameter.value = 0.2; // bank change, the fader now drives a track sitting at 0.2
+    
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.88, 0.85 }));
+    CHECK_CLOSE(0.2, parameter.value);
+    CHECK( ! softTakeover.GetIsCaught());
+    
+    // Approach from above
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.7, 0.5, 0.3 }));
+    CHECK_EQUAL(2, parameter.Replay(softTakeover, { 0.21, 0.15 }));
+    CHECK_CLOSE(0.15, parameter.value);
+    
+    parameter.value = 0.8; // and back, this track is above the fader
+    
+    // Approach from below, jumping past the parameter
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.2, 0.4, 0.6 }));
+    CHECK_EQUAL(1, parameter.Replay(softTakeover, { 0.95 }));
+    CHECK_CLOSE(0.95, parameter.value);
+}
+
+TEST(SoftTakeoverLetsGoWhenParameterMovedElsewhere)
+{
+    SoftTakeover softTakeover;
+    SimulatedParameter parameter;
+    parameter.value = 0.5;
+    
+    CHECK_EQUAL(1, parameter.Replay(softTakeover, { 0.51 }));
+    
+    parameter.value = 0.52; // automation nudges it, still inside the window
+    
+    CHECK_EQUAL(1, parameter.Replay(softTakeover, { 0.53 }));
+    
+    parameter.value = 0.1; // the mouse drags it away
+    
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.54 }));
+    CHECK_CLOSE(0.44, softTakeover.GetOffset());
+}
+
+TEST(SoftTakeoverWindowAndReset)
+{
+    SoftTakeover softTakeover;
+    SimulatedParameter parameter;
+    parameter.value = 0.5;
+    
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.45 }, 0.0025)); // 14 bit window
+    CHECK_EQUAL(1, parameter.Replay(softTakeover, { 0.45 }, 0.1));
+    
+    softTakeover.Reset();
+    
+    CHECK( ! softTakeover.GetIsCaught());
+    CHECK_CLOSE(0.0, softTakeover.GetOffset());
+    
+    parameter.value = 0.9;
+    
+    // Nothing from before the reset counts, crossings are measured from the first message after it
+    CHECK_EQUAL(0, parameter.Replay(softTakeover, { 0.3 }));
+    CHECK_EQUAL(1, parameter.Replay(softTakeover, { 0.95 }));
+}
@@ -0,0 +1,230 @@
+//
+//  test_zone_cache.cpp
+//  reaper_csurf_integrator tests
+//
+//  Compiled zone cache -- an entry is only used while it matches the .zon file, and the cold versus warm load benchmark
+//
+
+#include "control_surface_integrator.h"
+
+#include "csi_test.h"
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class TempFolder
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+{
+    // A scratch folder under /tmp, removed with everything in it when this goes out of scope
+private:
+    string path_ = "";
+    
+public:
+    TempFolder()
+    {
+        char folderTemplate[] = "/tmp/csi_tests_XXXXXX";
+        
+        if(mkdtemp(folderTemplate) != nullptr)
+            path_ = string(folderTemplate) + "/";
+    }
+    
+    ~TempFolder()
+    {
+        if(path_ == "")
+            return;
+        
+        if(DIR* dir = opendir(path_.c_str()))
+        {
+            while(dirent* entry = readdir(dir))
+                if(entry->d_name[0] != '.')
+                    remove((path_ + entry->d_name).c_str());
+            
+            closedir(dir);
+        }
+        
+        rmdir(path_.c_str());
+    }
+    
+    string GetPath() { return path_; }
+    
+    int GetNumFiles()
+    {
+        int numFiles = 0;
+        
+        if(DIR* dir = opendir(path_.c_str()))
+        {
+            while(dirent* entry = readdir(dir))
+                if(entry->d_name[0] != '.')
+                    numFiles++;
+            
+            closedir(dir);
+        }
+        
+        return numFiles;
+    }
+};
+
+static void WriteFile(const string &filePath, const string &contents)
+{
+    FILE* file = fopen(filePath.c_str(), "wb");
+    
+    if(file == nullptr)
+        return;
+    
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+}
+
+static void SetFileTime(const string &filePath, time_t time)
+{
+    utimbuf times;
+    times.actime = time;
+    times.modtime = time;
+    
+    utime(filePath.c_str(), &times);
+}
+
+static string GetZoneText(const string &zoneName, int numWidgets, const string &actionName)
+{
+    string zoneText = "Zone \"" + zoneName + "\"\n    TrackNavigator\n";
+    
+    for(int i = 1; i <= numWidgets; i++)
+    {
+        string number = to_string(i);
+        
+        zoneText += "    Fader" + number + "        " + actionName + " // channel " + number + "\n";
+        zoneText += "    Shift+Rotary" + number + "  TrackPan [ 0.0>1.0 (0.01) ]\n";
+        zoneText += "    Property+Rotary" + number + " SoftTakeover 0.05\n";
+        zoneText += "    Hold+Mute" + number + "     TrackMute \"Mute " + number + "\"\n";
+    }
+    
+    return zoneText + "ZoneEnd\n";
+}
+
+// The folder holds a single compiled entry in these tests
+static string GetCacheEntryPath(TempFolder &cacheFolder)
+{
+    string entryPath = "";
+    
+    if(DIR* dir = opendir(cacheFolder.GetPath().c_str()))
+    {
+        while(dirent* entry = readdir(dir))
+            if(entry->d_name[0] != '.')
+                entryPath = cacheFolder.GetPath() + entry->d_name;
+        
+        closedir(dir);
+    }
+    
+    return entryPath;
+}
+
+static string ReadFile(const string &filePath)
+{
+    string contents;
+    
+    if(FILE* file = fopen(filePath.c_str(), "rb"))
+    {
+        char buffer[4096];
+        
+        for(size_t size; (size = fread(buffer, 1, sizeof(buffer), file)) > 0; )
+            contents.append(buffer, size);
+        
+        fclose(file);
+    }
+    
+    return contents;
+}
+
+TEST(ZoneCacheEntryUsedWhileFileUnchanged)
+{
+    TempFolder zoneFolder;
+    TempFolder cacheFolder;
+    
+    string filePath = zoneFolder.GetPath() + "Track.zon";
+    WriteFile(filePath, GetZoneText("Track", 4, "TrackVolume"));
+    
+    ZonePreloader::SetCacheFolder(cacheFolder.GetPath());
+    
+    CHECK(ZonePreloader().LoadZoneFile(filePath) != nullptr);
+    CHECK_EQUAL(1, cacheFolder.GetNumFiles());
+    
+    // Backdate the entry, a rewrite would move its mtime on
+    string entryPath = GetCacheEntryPath(cacheFolder);
+    SetFileTime(entryPath, 1600000000);
+    
+    CHECK(ZonePreloader().LoadZoneFile(filePath) != nullptr); // a fresh store, so this has to come from the compiled entry
+    
+    struct stat entryStat;
+    
+    CHECK(stat(entryPath.c_str(), &entryStat) == 0 && entryStat.st_mtime == 1600000000);
+    CHECK_EQUAL(1, cacheFolder.GetNumFiles());
+    
+    ZonePreloader::SetCacheFolder("");
+}
+
+TEST(ZoneCacheEntryReplacedAfterSameSizeEdit)
+{
+    TempFolder zoneFolder;
+    TempFolder cacheFolder;
+    
+    string filePath = zoneFolder.GetPath() + "Track.zon";
+    
+    // Same size, same mtime -- only the contents tell the two apart
+    WriteFile(filePath, GetZoneText("Track", 4, "Track1Volume"));
+    SetFileTime(filePath, 1600000000);
+    
+    ZonePreloader::SetCacheFolder(cacheFolder.GetPath());
+    
+    CHECK(ZonePreloader().LoadZoneFile(filePath) != nullptr);
+    CHECK(ReadFile(GetCacheEntryPath(cacheFolder)).find("Track1Volume") != string::npos);
+    
+    WriteFile(filePath, GetZoneText("Track", 4, "Track2Volume"));
+    SetFileTime(filePath, 1600000000);
+    
+    CHECK(ZonePreloader().LoadZoneFile(filePath) != nullptr);
+    
+    string entry = ReadFile(GetCacheEntryPath(cacheFolder));
+    
+    CHECK(entry.find("Track2Volume") != string::npos); // reparsed and written again, not loaded from the stale entry
+    CHECK(entry.find("Track1Volume") == string::npos);
+    
+    ZonePreloader::SetCacheFolder("");
+}
+
+BENCHMARK(ZoneLoadColdVersusWarm)
+{
+    const int numFiles = 200;
+    
+    TempFolder zoneFolder;
+    TempFolder cacheFolder;
+    vector<string> filePaths;
+    
+    for(int i = 0; i < numFiles; i++)
+    {
+        filePaths.push_back(zoneFolder.GetPath() + "Zone" + to_string(i) + ".zon");
+        WriteFile(filePaths.back(), GetZoneText("Zone" + to_string(i), 24, "TrackVolume"));
+    }
+    
+    auto loadAll = [&filePaths]()
+    {
+        ZonePreloader zoneStore; // empty every run, so nothing comes from memory
+        
+        for(auto &filePath : filePaths)
+            zoneStore.LoadZoneFile(filePath);
+    };
+    
+    ZonePreloader::SetCacheFolder("");
+    double noCache = GetMicrosecondsPerRun(3, loadAll);
+    
+    ZonePreloader::SetCacheFolder(cacheFolder.GetPath());
+    double cold = GetMicrosecondsPerRun(1, loadAll); // parses and writes every entry
+    double warm = GetMicrosecondsPerRun(3, loadAll);
+    
+    ZonePreloader::SetCacheFolder("");
+    
+    printf("    %d zone files, ms per pass: no cache %.2f, cold %.2f, warm %.2f\n", numFiles, noCache / 1000.0, cold / 1000.0, warm / 1000.0);
+}